@@ -38,6 +38,7 @@ static ableton::link::HostTimeFilter<ableton::link::platform::Clock> sHostTimeFi
 
 AbletonLink::AbletonLink()
 {
+   SetPollRate(kMaxPollRate);
    sHostTimeFilter.reset();
 
    mNumPeers = 0;
@@ -67,7 +67,7 @@ private:
    int mRouteIndex{ 0 };
    RadioButton* mRouteSelector{ nullptr };
    std::vector<PatchCableSource*> mDestinationCables;
-   RollingBuffer mBlankVizBuffer;
+   VizBuffer mBlankVizBuffer;
 
    std::array<Ramp, 16> mSwitchAndRampIn;
    int mLastProcessedRouteIndex{ 0 };
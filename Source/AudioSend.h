@@ -29,7 +29,7 @@
 #include <iostream>
 #include "IAudioProcessor.h"
 #include "IDrawableModule.h"
-#include "RollingBuffer.h"
+#include "VizBuffer.h"
 #include "PatchCableSource.h"
 #include "Slider.h"
 
@@ -62,6 +62,7 @@ public:
 private:
    //IDrawableModule
    void DrawModule() override;
+   bool CanCacheDrawing() const override { return true; }
    void GetModuleDimensions(float& w, float& h) override
    {
       w = 86;
@@ -73,6 +74,6 @@ private:
    Checkbox* mCrossfadeCheckbox{ nullptr };
    float mAmount{ 0 };
    FloatSlider* mAmountSlider{ nullptr };
-   RollingBuffer mVizBuffer2;
+   VizBuffer mVizBuffer2;
    PatchCableSource* mPatchCableSource2{ nullptr };
 };
@@ -44,6 +44,7 @@ const float mRemixBufferY = mBufferY + mBufferH + 60;
 BeatBloks::BeatBloks()
 : mRemixZoomEnd(gSampleRate * 25)
 {
+   SetPollRate(kMaxPollRate);
    mWriteBuffer = new float[gBufferSize];
    Clear(mWriteBuffer, gBufferSize);
    mSample = new Sample();
@@ -65,6 +65,9 @@ Canvas::Canvas(IDrawableModule* parent, int x, int y, int w, int h, float length
 
    for (size_t i = 0; i < mRowColors.size(); ++i)
       mRowColors[i] = ofColor(200, 200, 200, 70);
+
+   mMovedElements.reserve(kMaxMovedElements);
+   mMovedElementsToUpdate.reserve(kMaxMovedElements);
 }
 
 Canvas::~Canvas()
@@ -150,7 +153,7 @@ void Canvas::Render()
 
 void Canvas::AddElement(CanvasElement* element)
 {
-   mElements.push_back(element);
+   mElements.push_back(element); //picked up by the next lookup, and inserted into the index
 }
 
 void Canvas::RemoveElement(CanvasElement* element)
@@ -158,6 +161,7 @@ void Canvas::RemoveElement(CanvasElement* element)
    if (mListener)
       mListener->ElementRemoved(element);
    RemoveFromVector(element, mElements, !K(fail));
+   MarkElementsChanged();
    //delete element; TODO(Ryan) figure out how to delete without messing up stuff accessing data from other thread
 }
 
@@ -362,6 +366,7 @@ bool Canvas::MouseMoved(float x, float y)
                }
                for (auto newElement : newElements)
                   mElements.push_back(newElement);
+               MarkElementsChanged();
             }
          }
       }
@@ -573,6 +578,7 @@ void Canvas::KeyPressed(int key, bool isRepeat)
             if (element->GetHighlighted())
                element->mCol += direction;
          }
+         MarkElementsMoved();
       }
       if (key == OF_KEY_UP || key == OF_KEY_DOWN)
       {
@@ -582,6 +588,7 @@ void Canvas::KeyPressed(int key, bool isRepeat)
             if (element->GetHighlighted())
                element->mRow += direction;
          }
+         MarkElementsMoved();
       }
    }
 }
@@ -595,6 +602,7 @@ void Canvas::RescaleNumCols(int cols)
       element->mLength *= ratio;
    }
    mNumCols = cols;
+   MarkElementsMoved();
 }
 
 void Canvas::SetRowColor(int row, ofColor color)
@@ -631,21 +639,221 @@ CanvasElement* Canvas::GetElementAt(float pos, int row)
    return nullptr;
 }
 
+void Canvas::MarkElementMoved(CanvasElement* element)
+{
+   mMovedElementsMutex.lock();
+   if ((int)mMovedElements.size() < kMaxMovedElements)
+      mMovedElements.push_back(element);
+   else
+      mElementIndexDirty = true;
+   mMovedElementsMutex.unlock();
+}
+
+void Canvas::UpdateElementIndex() const
+{
+   //clear the flags before reading anything, so a change that lands while we update marks the index dirty again
+   bool rebuild = mElementListChanged.exchange(false);
+   rebuild = mElementIndexDirty.exchange(false) || rebuild;
+
+   mMovedElementsMutex.lock();
+   mMovedElementsToUpdate.swap(mMovedElements);
+   mMovedElements.clear();
+   mMovedElementsMutex.unlock();
+
+   if (rebuild)
+   {
+      RebuildElementIndex();
+   }
+   else
+   {
+      for (auto* element : mMovedElementsToUpdate)
+         UpdateMovedElement(element);
+      for (int i = mNumIndexedElements; i < (int)mElements.size(); ++i)
+         InsertIntoElementIndex(mElements[i], i);
+   }
+   mNumIndexedElements = (int)mElements.size();
+}
+
+void Canvas::RebuildElementIndex() const
+{
+   mElementIndex.resize(mElements.size());
+   for (int i = 0; i < (int)mElements.size(); ++i)
+   {
+      mElementIndex[i].mStart = mElements[i]->GetStart();
+      mElementIndex[i].mEnd = mElements[i]->GetEnd();
+      mElementIndex[i].mOrder = i;
+      mElementIndex[i].mElement = mElements[i];
+   }
+   std::sort(mElementIndex.begin(), mElementIndex.end(), [](const IndexedElement& a, const IndexedElement& b)
+             {
+                return a.mStart < b.mStart;
+             });
+
+   mEndTreeLeaves = 1;
+   while (mEndTreeLeaves < (int)mElementIndex.size())
+      mEndTreeLeaves *= 2;
+   mEndTree.assign(mEndTreeLeaves * 2, -FLT_MAX);
+   if (!mElementIndex.empty())
+      RefreshElementIndexRange(0, (int)mElementIndex.size() - 1);
+}
+
+void Canvas::InsertIntoElementIndex(CanvasElement* element, int order) const
+{
+   IndexedElement indexed;
+   indexed.mStart = element->GetStart();
+   indexed.mEnd = element->GetEnd();
+   indexed.mOrder = order;
+   indexed.mElement = element;
+   auto insertAt = std::upper_bound(mElementIndex.begin(), mElementIndex.end(), indexed.mStart, [](float pos, const IndexedElement& other)
+                                    {
+                                       return pos < other.mStart;
+                                    });
+   int slot = int(insertAt - mElementIndex.begin());
+   mElementIndex.insert(insertAt, indexed);
+
+   if ((int)mElementIndex.size() > mEndTreeLeaves)
+   {
+      //out of leaves, so double the tree and fill it all back in
+      mEndTreeLeaves *= 2;
+      mEndTree.assign(mEndTreeLeaves * 2, -FLT_MAX);
+      slot = 0;
+   }
+   //everything after the new element moved up a slot
+   RefreshElementIndexRange(slot, (int)mElementIndex.size() - 1);
+}
+
+void Canvas::UpdateMovedElement(CanvasElement* element) const
+{
+   int slot = element->mIndexSlot;
+   if (slot < 0 || slot >= (int)mElementIndex.size() || mElementIndex[slot].mElement != element)
+      return; //not indexed yet, it'll be read fresh when it's inserted
+
+   IndexedElement& indexed = mElementIndex[slot];
+   indexed.mEnd = element->GetEnd();
+   float start = element->GetStart();
+   if (start == indexed.mStart)
+   {
+      //only the end changed (like a note growing while it's recorded), so it keeps its place
+      RefreshElementIndexRange(slot, slot);
+      return;
+   }
+
+   //slide it over to where its new start belongs
+   indexed.mStart = start;
+   int newSlot = slot;
+   while (newSlot > 0 && mElementIndex[newSlot - 1].mStart > start)
+      --newSlot;
+   while (newSlot < (int)mElementIndex.size() - 1 && mElementIndex[newSlot + 1].mStart < start)
+      ++newSlot;
+   if (newSlot < slot)
+      std::rotate(mElementIndex.begin() + newSlot, mElementIndex.begin() + slot, mElementIndex.begin() + slot + 1);
+   else if (newSlot > slot)
+      std::rotate(mElementIndex.begin() + slot, mElementIndex.begin() + slot + 1, mElementIndex.begin() + newSlot + 1);
+   RefreshElementIndexRange(MIN(slot, newSlot), MAX(slot, newSlot));
+}
+
+//updates the slots and the end tree for the index entries from first to last
+void Canvas::RefreshElementIndexRange(int first, int last) const
+{
+   for (int i = first; i <= last; ++i)
+   {
+      mElementIndex[i].mElement->mIndexSlot = i;
+      mEndTree[mEndTreeLeaves + i] = mElementIndex[i].mEnd;
+   }
+   for (int l = (mEndTreeLeaves + first) / 2, r = (mEndTreeLeaves + last) / 2; l >= 1; l /= 2, r /= 2)
+   {
+      for (int node = l; node <= r; ++node)
+         mEndTree[node] = MAX(mEndTree[node * 2], mEndTree[node * 2 + 1]);
+   }
+}
+
+//adds every indexed element that touches [start, end] to mIndexLookup
+void Canvas::CollectIndexedElements(float start, float end) const
+{
+   auto firstAfter = std::upper_bound(mElementIndex.begin(), mElementIndex.end(), end, [](float pos, const IndexedElement& indexed)
+                                      {
+                                         return pos < indexed.mStart;
+                                      });
+   int count = int(firstAfter - mElementIndex.begin());
+   if (count > 0)
+      CollectFromEndTree(1, 0, mEndTreeLeaves, count, start);
+}
+
+//everything in the first count entries that ends at or after start, skipping whole subtrees that end before it,
+//so a lookup costs about log(n) per element found no matter how long the elements are
+void Canvas::CollectFromEndTree(int node, int nodeFirst, int nodeSize, int count, float start) const
+{
+   if (nodeFirst >= count || mEndTree[node] < start)
+      return;
+   if (nodeSize == 1)
+   {
+      mIndexLookup.push_back(&mElementIndex[nodeFirst]);
+      return;
+   }
+   CollectFromEndTree(node * 2, nodeFirst, nodeSize / 2, count, start);
+   CollectFromEndTree(node * 2 + 1, nodeFirst + nodeSize / 2, nodeSize / 2, count, start);
+}
+
 void Canvas::FillElementsAt(float pos, std::vector<CanvasElement*>& elementsAt) const
 {
-   for (int i = 0; i < mElements.size(); ++i)
+   UpdateElementIndex();
+
+   mIndexLookup.clear();
+   CollectIndexedElements(pos, pos);
+   if (mWrap)
+      CollectIndexedElements(pos + mLength, pos + mLength);
+
+   //later elements win a row, same as scanning mElements in order
+   std::sort(mIndexLookup.begin(), mIndexLookup.end(), [](const IndexedElement* a, const IndexedElement* b)
+             {
+                return a->mOrder < b->mOrder;
+             });
+
+   for (const IndexedElement* indexed : mIndexLookup)
    {
-      if (mElements[i]->mRow == -1 || mElements[i]->mCol == -1 || mElements[i]->mRow >= elementsAt.size())
+      CanvasElement* element = indexed->mElement;
+      if (element->mRow == -1 || element->mCol == -1 || element->mRow >= elementsAt.size())
          continue;
 
       bool on = false;
-      if (pos >= mElements[i]->GetStart() && pos < mElements[i]->GetEnd())
+      if (pos >= element->GetStart() && pos < element->GetEnd())
          on = true;
-      if (mWrap && pos >= mElements[i]->GetStart() - mLength && pos < mElements[i]->GetEnd() - mLength)
+      if (mWrap && pos >= element->GetStart() - mLength && pos < element->GetEnd() - mLength)
          on = true;
       if (on)
-         elementsAt[mElements[i]->mRow] = mElements[i];
+         elementsAt[element->mRow] = element;
+   }
+}
+
+//every element that could overlap the range from start to end, in the order they were added. if end is before start,
+//the range wraps around the end of the canvas. elements that run past the end of the canvas are checked as if they
+//had wrapped back around, too. callers should still do their own exact checks
+void Canvas::FillElementsInRange(float start, float end, std::vector<CanvasElement*>& elements) const
+{
+   UpdateElementIndex();
+
+   mIndexLookup.clear();
+   if (start <= end)
+   {
+      CollectIndexedElements(start, end);
+      CollectIndexedElements(start + mLength, end + mLength);
    }
+   else
+   {
+      CollectIndexedElements(start, end + mLength);
+      CollectIndexedElements(-FLT_MAX, end);
+      CollectIndexedElements(start + mLength, FLT_MAX);
+   }
+
+   std::sort(mIndexLookup.begin(), mIndexLookup.end(), [](const IndexedElement* a, const IndexedElement* b)
+             {
+                return a->mOrder < b->mOrder;
+             });
+   mIndexLookup.erase(std::unique(mIndexLookup.begin(), mIndexLookup.end()), mIndexLookup.end());
+
+   elements.clear();
+   for (const IndexedElement* indexed : mIndexLookup)
+      elements.push_back(indexed->mElement);
 }
 
 void Canvas::EraseElementsAt(float pos)
@@ -683,6 +891,7 @@ CanvasCoord Canvas::GetCoordAt(int x, int y)
 void Canvas::Clear()
 {
    mElements.clear();
+   MarkElementsChanged();
 }
 
 namespace
@@ -739,4 +948,5 @@ void Canvas::LoadState(FileStreamIn& in, bool shouldSetValue)
       element->LoadState(in);
       mElements.push_back(element);
    }
+   MarkElementsChanged();
 }
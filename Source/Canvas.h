@@ -26,6 +26,7 @@
 #ifndef __Bespoke__Canvas__
 #define __Bespoke__Canvas__
 
+#include <atomic>
 #include <iostream>
 #include "IUIControl.h"
 #include "CanvasElement.h"
@@ -96,7 +97,11 @@ public:
    void SetLength(float length) { mLength = length; }
    float GetLength() const { return mLength; }
    void SetNumRows(int rows) { mNumRows = rows; }
-   void SetNumCols(int cols) { mNumCols = cols; }
+   void SetNumCols(int cols)
+   {
+      mNumCols = cols;
+      MarkElementsMoved();
+   }
    int GetNumRows() const { return mNumRows; }
    int GetNumCols() const { return mNumCols; }
    void RescaleNumCols(int cols);
@@ -108,6 +113,9 @@ public:
    CanvasControls* GetControls() { return mControls; }
    std::vector<CanvasElement*>& GetElements() { return mElements; }
    void FillElementsAt(float pos, std::vector<CanvasElement*>& elements) const;
+   void FillElementsInRange(float start, float end, std::vector<CanvasElement*>& elements) const;
+   void MarkElementsMoved() { mElementIndexDirty = true; }
+   void MarkElementMoved(CanvasElement* element);
    void EraseElementsAt(float pos);
    CanvasElement* GetElementAt(float pos, int row);
    void SetCursorPos(float pos) { mCursorPos = pos; }
@@ -152,6 +160,14 @@ private:
 
    bool IsOnElement(CanvasElement* element, float x, float y) const;
    float QuantizeToGrid(float input) const;
+   void MarkElementsChanged() { mElementListChanged = true; }
+   void UpdateElementIndex() const;
+   void RebuildElementIndex() const;
+   void InsertIntoElementIndex(CanvasElement* element, int order) const;
+   void UpdateMovedElement(CanvasElement* element) const;
+   void RefreshElementIndexRange(int first, int last) const;
+   void CollectIndexedElements(float start, float end) const;
+   void CollectFromEndTree(int node, int nodeFirst, int nodeSize, int count, float start) const;
 
    bool mClick;
    CanvasElement* mClickedElement;
@@ -161,6 +177,28 @@ private:
    float mLength;
    ICanvasListener* mListener;
    std::vector<CanvasElement*> mElements;
+
+   //mElements sorted by start, so playback only looks at elements near the cursor. elements get edited in place all over the place,
+   //so anything that moves one calls MarkElementMoved() (or MarkElementsMoved() for many at once), and the index is brought up to
+   //date on the next lookup. elements added with AddElement() are inserted into it rather than forcing a rebuild
+   struct IndexedElement
+   {
+      float mStart;
+      float mEnd;
+      int mOrder; //position in mElements
+      CanvasElement* mElement;
+   };
+   mutable std::vector<IndexedElement> mElementIndex;
+   mutable std::vector<float> mEndTree; //max segment tree over the ends in mElementIndex, with its leaves from mEndTreeLeaves
+   mutable int mEndTreeLeaves{ 0 };
+   mutable int mNumIndexedElements{ 0 }; //mElements past this were added since the last update
+   mutable std::vector<const IndexedElement*> mIndexLookup;
+   mutable std::atomic<bool> mElementIndexDirty{ true };
+   mutable std::atomic<bool> mElementListChanged{ true };
+   static const int kMaxMovedElements = 64; //past this many between lookups, just rebuild
+   mutable std::vector<CanvasElement*> mMovedElements;
+   mutable std::vector<CanvasElement*> mMovedElementsToUpdate;
+   mutable ofMutex mMovedElementsMutex;
    CanvasControls* mControls;
    float mCursorPos;
    CreateCanvasElementFn mElementCreator;
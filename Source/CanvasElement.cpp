@@ -186,6 +186,7 @@ void CanvasElement::SetStart(float start, bool preserveLength)
    mOffset = start - mCol;
    if (!preserveLength)
       SetEnd(end);
+   mCanvas->MarkElementMoved(this);
 }
 
 float CanvasElement::GetEnd() const
@@ -196,6 +197,7 @@ float CanvasElement::GetEnd() const
 void CanvasElement::SetEnd(float end)
 {
    mLength = end * mCanvas->GetNumCols() - mCol - mOffset;
+   mCanvas->MarkElementMoved(this);
 }
 
 ofRectangle CanvasElement::GetRect(bool clamp, bool wrapped, ofVec2f offset) const
@@ -257,6 +259,7 @@ void CanvasElement::MoveElementByDrag(ofVec2f dragOffset)
    mRow = newRow;
    mCol = newCol;
    mOffset = newOffset;
+   mCanvas->MarkElementMoved(this);
 }
 
 void CanvasElement::AddElementUIControl(IUIControl* control)
@@ -281,6 +284,7 @@ void CanvasElement::FloatSliderUpdated(std::string label, float oldVal, float ne
       if (control->Name() == label)
          control->SetValue(newVal);
    }
+   mCanvas->MarkElementMoved(this);
 }
 
 void CanvasElement::IntSliderUpdated(std::string label, int oldVal, float newVal)
@@ -290,6 +294,7 @@ void CanvasElement::IntSliderUpdated(std::string label, int oldVal, float newVal
       if (control->Name() == label)
          control->SetValue(newVal);
    }
+   mCanvas->MarkElementMoved(this);
 }
 
 void CanvasElement::ButtonClicked(std::string label)
@@ -322,6 +327,7 @@ void CanvasElement::LoadState(FileStreamIn& in)
    }
    in >> mOffset;
    in >> mLength;
+   mCanvas->MarkElementMoved(this);
 }
 
 ////////////////////
@@ -521,6 +527,7 @@ void SampleCanvasElement::ButtonClicked(std::string label)
          mLength = lengthOriginalSpeed;
       }
    }
+   mCanvas->MarkElementMoved(this);
 }
 
 void SampleCanvasElement::DrawContents(bool clamp, bool wrapped, ofVec2f offset)
@@ -73,6 +73,7 @@ public:
    int mCol;
    float mOffset;
    float mLength;
+   int mIndexSlot{ -1 }; //position in the canvas's element index, kept up to date by Canvas
 
 protected:
    virtual void DrawContents(bool clamp, bool wrapped, ofVec2f offset) = 0;
@@ -65,6 +65,7 @@ private:
 
    //IDrawableModule
    void DrawModule() override;
+   bool CanCacheDrawing() const override { return true; }
    void GetModuleDimensions(float& width, float& height) override
    {
       width = mWidth;
@@ -26,6 +26,8 @@
 */
 
 #include "ChannelBuffer.h"
+#include "WaveformPyramid.h"
+#include "LoopPagePool.h"
 
 ChannelBuffer::ChannelBuffer(int bufferSize)
 {
@@ -45,6 +47,7 @@ ChannelBuffer::ChannelBuffer(float* data, int bufferSize)
    mBuffers = new float*[1];
    mBuffers[0] = data;
    mBufferSize = bufferSize;
+   mLoopPageRuns.assign(1, -1);
 }
 
 ChannelBuffer::~ChannelBuffer()
@@ -52,7 +55,7 @@ ChannelBuffer::~ChannelBuffer()
    if (mOwnsBuffers)
    {
       for (int i = 0; i < mNumChannels; ++i)
-         delete[] mBuffers[i];
+         FreeChannel(i);
    }
    delete[] mBuffers;
 }
@@ -64,10 +67,33 @@ void ChannelBuffer::Setup(int bufferSize)
 
    for (int i = 0; i < mNumChannels; ++i)
       mBuffers[i] = nullptr;
+   mLoopPageRuns.assign(mNumChannels, -1);
 
    Clear();
 }
 
+void ChannelBuffer::AllocateChannel(int channel)
+{
+   assert(mOwnsBuffers);
+   assert(!mUsesLoopPagePool || mBufferSize == 0); //pooled channels all come from SetMinimumSize()
+   mBuffers[channel] = new float[mBufferSize];
+   ::Clear(mBuffers[channel], mBufferSize);
+}
+
+void ChannelBuffer::FreeChannel(int channel)
+{
+   if (mLoopPageRuns[channel] != -1)
+   {
+      LoopPagePool::Get()->Retire(mLoopPageRuns[channel]);
+      mLoopPageRuns[channel] = -1;
+   }
+   else
+   {
+      delete[] mBuffers[channel];
+   }
+   mBuffers[channel] = nullptr;
+}
+
 float* ChannelBuffer::GetChannel(int channel)
 {
    if (channel >= mActiveChannels)
@@ -75,10 +101,8 @@ float* ChannelBuffer::GetChannel(int channel)
    float* ret = mBuffers[MIN(channel, mActiveChannels - 1)];
    if (ret == nullptr)
    {
-      assert(mOwnsBuffers);
-      ret = new float[BufferSize()];
-      ::Clear(ret, BufferSize());
-      mBuffers[MIN(channel, mActiveChannels - 1)] = ret;
+      AllocateChannel(MIN(channel, mActiveChannels - 1));
+      ret = mBuffers[MIN(channel, mActiveChannels - 1)];
    }
    return ret;
 }
@@ -90,6 +114,7 @@ void ChannelBuffer::Clear() const
       if (mBuffers[i] != nullptr)
          ::Clear(mBuffers[i], BufferSize());
    }
+   WaveformChanged();
 }
 
 void ChannelBuffer::SetMaxAllowedChannels(int channels)
@@ -104,10 +129,11 @@ void ChannelBuffer::SetMaxAllowedChannels(int channels)
    }
 
    for (int i = channels; i < mNumChannels; ++i)
-      delete[] mBuffers[i];
+      FreeChannel(i);
    delete[] mBuffers;
 
    mBuffers = newBuffers;
+   mLoopPageRuns.resize(channels, -1);
    mNumChannels = channels;
    if (mActiveChannels > channels)
       mActiveChannels = channels;
@@ -125,38 +151,110 @@ void ChannelBuffer::CopyFrom(ChannelBuffer* src, int length /*= -1*/, int startO
       if (src->mBuffers[i])
       {
          if (mBuffers[i] == nullptr)
-         {
-            assert(mOwnsBuffers);
-            mBuffers[i] = new float[mBufferSize];
-            ::Clear(mBuffers[i], mBufferSize);
-         }
+            AllocateChannel(i);
          BufferCopy(mBuffers[i], src->mBuffers[i] + startOffset, length);
       }
-      else
+      else if (mBuffers[i] != nullptr)
       {
-         delete mBuffers[i];
-         mBuffers[i] = nullptr;
+         if (mUsesLoopPagePool)
+            ::Clear(mBuffers[i], length); //keep pooled channels, so the audio thread never has to find new ones
+         else
+            FreeChannel(i);
       }
    }
+   WaveformChanged(0, length);
 }
 
 void ChannelBuffer::SetChannelPointer(float* data, int channel, bool deleteOldData)
 {
    if (deleteOldData)
-      delete[] mBuffers[channel];
+      FreeChannel(channel);
    mBuffers[channel] = data;
+   mLoopPageRuns[channel] = -1;
+   WaveformChanged();
 }
 
 void ChannelBuffer::Resize(int bufferSize)
 {
    assert(mOwnsBuffers);
    for (int i = 0; i < mNumChannels; ++i)
-      delete[] mBuffers[i];
+      FreeChannel(i);
    delete[] mBuffers;
 
    Setup(bufferSize);
 }
 
+void ChannelBuffer::UseLoopPagePool()
+{
+   assert(mOwnsBuffers);
+   for (int i = 0; i < mNumChannels; ++i)
+      FreeChannel(i);
+   mUsesLoopPagePool = true;
+}
+
+bool ChannelBuffer::SetMinimumSize(int bufferSize)
+{
+   if (bufferSize <= mBufferSize)
+      return true;
+   if (!mUsesLoopPagePool)
+      return false;
+
+   //get every run up front, so that running out leaves the buffer as it was rather than half grown
+   assert(mNumChannels <= kMaxNumChannels);
+   int newRuns[kMaxNumChannels];
+   for (int i = 0; i < mNumChannels; ++i)
+   {
+      newRuns[i] = LoopPagePool::Get()->AcquireRun(bufferSize);
+      if (newRuns[i] == -1)
+      {
+         for (int j = 0; j < i; ++j)
+            LoopPagePool::Get()->Release(newRuns[j]);
+         return false;
+      }
+   }
+
+   //every channel gets a run, even unused ones, so GetChannel() never has to allocate later
+   int newBufferSize = LoopPagePool::Get()->GetSize(newRuns[0]);
+   for (int i = 1; i < mNumChannels; ++i)
+      newBufferSize = MIN(newBufferSize, LoopPagePool::Get()->GetSize(newRuns[i]));
+   for (int i = 0; i < mNumChannels; ++i)
+   {
+      float* data = LoopPagePool::Get()->GetData(newRuns[i]);
+      int keepLength = mBuffers[i] != nullptr ? mBufferSize : 0;
+      if (keepLength > 0)
+         BufferCopy(data, mBuffers[i], keepLength);
+      ::Clear(data + keepLength, newBufferSize - keepLength);
+
+      //swap the new run in with a single store, so a reader never sees the channel missing
+      float* oldData = mBuffers[i];
+      int oldRun = mLoopPageRuns[i];
+      mBuffers[i] = data;
+      mLoopPageRuns[i] = newRuns[i];
+      if (oldRun != -1)
+         LoopPagePool::Get()->Retire(oldRun);
+      else
+         delete[] oldData; //only a heap channel from before the buffer had a size
+   }
+   mBufferSize = newBufferSize;
+   WaveformChanged();
+   return true;
+}
+
+void ChannelBuffer::EnableWaveformPyramid()
+{
+   if (mWaveformPyramid == nullptr)
+   {
+      mWaveformPyramid = std::make_unique<WaveformPyramid>();
+      WaveformChanged();
+   }
+}
+
+void ChannelBuffer::WaveformChanged(int start /*= 0*/, int length /*= -1*/) const
+{
+   if (mWaveformPyramid != nullptr)
+      mWaveformPyramid->Invalidate(start, length == -1 ? mBufferSize - start : length);
+}
+
 namespace
 {
    const int kSaveStateRev = 1;
@@ -200,4 +298,5 @@ void ChannelBuffer::Load(FileStreamIn& in, int& readLength, LoadMode loadMode)
       if (hasBuffer)
          in.Read(GetChannel(i), readLength);
    }
+   WaveformChanged(0, readLength);
 }
@@ -29,6 +29,11 @@
 #include "SynthGlobals.h"
 #include "FileStream.h"
 
+#include <memory>
+#include <vector>
+
+class WaveformPyramid;
+
 class ChannelBuffer
 {
 public:
@@ -55,6 +60,11 @@ public:
       SetNumActiveChannels(1);
    }
    void Resize(int bufferSize);
+   void UseLoopPagePool(); //take channels from LoopPagePool rather than the heap, so that SetMinimumSize() can grow them without allocating
+   bool SetMinimumSize(int bufferSize); //grows pooled channels, keeping their contents. never allocates, returns false if the pool has nothing big enough
+   void EnableWaveformPyramid();
+   WaveformPyramid* GetWaveformPyramid() const { return mWaveformPyramid.get(); }
+   void WaveformChanged(int start = 0, int length = -1) const; //call after writing into the channels directly, so the pyramid (if enabled) catches up
 
    enum class LoadMode
    {
@@ -70,6 +80,8 @@ public:
 
 private:
    void Setup(int bufferSize);
+   void AllocateChannel(int channel);
+   void FreeChannel(int channel);
 
    int mActiveChannels{ 1 };
    int mNumChannels{ 1 };
@@ -77,4 +89,7 @@ private:
    float** mBuffers;
    int mRecentActiveChannels{ 1 };
    bool mOwnsBuffers{ true };
+   bool mUsesLoopPagePool{ false };
+   std::vector<int> mLoopPageRuns; //LoopPagePool run backing each channel, -1 for channels from the heap
+   std::unique_ptr<WaveformPyramid> mWaveformPyramid;
 };
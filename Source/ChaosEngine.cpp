@@ -34,6 +34,7 @@ ChaosEngine* TheChaosEngine = nullptr;
 
 ChaosEngine::ChaosEngine()
 {
+   SetPollRate(kMaxPollRate);
    assert(TheChaosEngine == nullptr);
    TheChaosEngine = this;
 
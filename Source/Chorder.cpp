@@ -43,6 +43,7 @@ Chorder::Chorder()
 {
    std::memset(mHeldCount, 0, TOTAL_NUM_NOTES * sizeof(int));
    std::memset(mInputNotes, 0, TOTAL_NUM_NOTES * sizeof(bool));
+   mOutputBlock.reserve(kOutputBlockReserve);
 
    TheScale->AddListener(this);
 }
@@ -274,6 +275,46 @@ void Chorder::PlayNote(double time, int pitch, int velocity, int voiceIdx, Modul
    CheckLeftovers();
 }
 
+//each input note fans out into a chord, and the whole block's worth of chord notes goes on as one block
+void Chorder::PlayNoteBlock(const std::vector<NoteInputElement>& notes)
+{
+   if (!mEnabled)
+   {
+      PlayNoteOutputBlock(notes);
+      return;
+   }
+   if (mInNoteOutput)
+   {
+      INoteReceiver::PlayNoteBlock(notes);
+      return;
+   }
+
+   mOutputBlock.clear();
+   mCollectingBlock = true;
+   for (const NoteInputElement& note : notes)
+      PlayNote(note.time, note.pitch, note.velocity, note.voiceIdx, note.modulation);
+   mCollectingBlock = false;
+   PlayNoteOutputBlock(mOutputBlock);
+}
+
+void Chorder::OutputNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation)
+{
+   if (mCollectingBlock)
+   {
+      NoteInputElement note;
+      note.time = time;
+      note.pitch = pitch;
+      note.velocity = velocity;
+      note.voiceIdx = voiceIdx;
+      note.modulation = modulation;
+      mOutputBlock.push_back(note);
+   }
+   else
+   {
+      PlayNoteOutput(time, pitch, velocity, voiceIdx, modulation);
+   }
+}
+
 void Chorder::PlayChorderNote(double time, int pitch, int velocity, int voice /*=-1*/, ModulationParameters modulation)
 {
    assert(velocity >= 0);
@@ -290,9 +331,9 @@ void Chorder::PlayChorderNote(double time, int pitch, int velocity, int voice /*
       --mHeldCount[pitch];
 
    if (mHeldCount[pitch] > 0 && !wasOn)
-      PlayNoteOutput(time, pitch, velocity, voice, modulation);
+      OutputNote(time, pitch, velocity, voice, modulation);
    if (mHeldCount[pitch] == 0 && wasOn)
-      PlayNoteOutput(time, pitch, 0, voice, modulation);
+      OutputNote(time, pitch, 0, voice, modulation);
 
    //ofLog() << ofToString(pitch) + " " + ofToString(velocity) + ": " + ofToString(mHeldCount[pitch]) + " " + ofToString(voice);
 }
@@ -316,7 +357,7 @@ void Chorder::CheckLeftovers()
          if (mHeldCount[i] > 0)
          {
             ofLog() << "Somehow there are still notes in the count! Clearing";
-            PlayNoteOutput(gTime, i, 0, -1);
+            OutputNote(gTime, i, 0, -1, ModulationParameters());
             mHeldCount[i] = 0;
          }
       }
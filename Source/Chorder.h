@@ -51,6 +51,7 @@ public:
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
+   void PlayNoteBlock(const std::vector<NoteInputElement>& notes) override;
 
    void GridUpdated(UIGrid* grid, int col, int row, float value, float oldValue) override;
 
@@ -80,6 +81,7 @@ private:
    bool MouseMoved(float x, float y) override;
 
    void PlayChorderNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation);
+   void OutputNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation);
    void CheckLeftovers();
    void SyncChord();
 
@@ -87,6 +89,7 @@ private:
    int mVelocity;
    bool mInputNotes[TOTAL_NUM_NOTES];
    int mHeldCount[TOTAL_NUM_NOTES];
+   bool mCollectingBlock{ false }; //inside PlayNoteBlock(), so output goes into mOutputBlock
 
    bool mDiatonic;
    int mChordIndex;
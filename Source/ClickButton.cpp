@@ -211,3 +211,10 @@ std::string ClickButton::GetDisplayValue(float val) const
       return "click";
    return "_";
 }
+
+size_t ClickButton::GetRenderHash()
+{
+   size_t hash = IUIControl::GetRenderHash();
+   HashCombine(hash, ButtonLit() ? gTime : 0); //keep changing while the press fades
+   return hash;
+}
@@ -84,6 +84,7 @@ public:
    void LoadState(FileStreamIn& in, bool shouldSetValue) override {}
    bool IsSliderControl() override { return false; }
    bool IsButtonControl() override { return true; }
+   size_t GetRenderHash() override;
 
 protected:
    ~ClickButton(); //protected so that it can't be created on the stack
@@ -29,6 +29,7 @@
 
 ClipArranger::ClipArranger()
 {
+   SetPollRate(kMaxPollRate);
 }
 
 ClipArranger::~ClipArranger()
@@ -47,7 +48,7 @@ void ClipArranger::Process(double time, float* left, float* right, int bufferSiz
    if (ArrangementController::mPlay)
    {
       for (int i = 0; i < MAX_CLIPS; ++i)
-         mClips[i].Process(left, right, bufferSize);
+         mClips[i].Process(time, left, right, bufferSize);
    }
 }
 
@@ -77,7 +78,8 @@ void ClipArranger::DrawModule()
                length *= newWidth / sampleWidth;
                sampleWidth = newWidth;
             }
-            DrawAudioBuffer(sampleWidth, mBufferHeight, mClips[i].mSample->Data(), 0, length, 0);
+            float drawLength = MIN(length, mClips[i].mSample->GetNumDecodedSamples()); //only the decoded head is in Data() while streaming
+            DrawAudioBuffer(sampleWidth * drawLength / length, mBufferHeight, mClips[i].mSample->Data(), 0, drawLength, 0);
             ofPopMatrix();
          }
 
@@ -190,13 +192,14 @@ bool ClipArranger::IsMousePosWithinClip(int x, int y)
 void ClipArranger::FilesDropped(std::vector<std::string> files, int x, int y)
 {
    Sample* sample = new Sample();
-   sample->Read(files[0].c_str());
+   sample->Read(files[0].c_str(), false, Sample::ReadType::Stream);
    AddSample(sample, x, y);
 }
 
 void ClipArranger::AddSample(Sample* sample, int x, int y)
 {
    Clip* clip = GetEmptyClip();
+   sample->SetLooping(true);
    clip->mSample = sample;
    clip->mStartSample = MouseXToSample(x);
    clip->mEndSample = MIN(clip->mStartSample + clip->mSample->LengthInSamples(), ArrangementController::mSampleLength);
@@ -248,22 +251,27 @@ void ClipArranger::SetUpFromSaveData()
 {
 }
 
-void ClipArranger::Clip::Process(float* left, float* right, int bufferSize)
+void ClipArranger::Clip::Process(double time, float* left, float* right, int bufferSize)
 {
    if (mSample == nullptr)
       return;
 
-   for (int i = 0; i < bufferSize; ++i)
-   {
-      int playhead = ArrangementController::mPlayhead + i;
+   int playhead = ArrangementController::mPlayhead;
+   int start = MAX(mStartSample - playhead, 0);
+   int end = MIN(mEndSample - playhead, bufferSize);
+   if (start >= end)
+      return;
 
-      if (playhead >= mStartSample &&
-          playhead < mEndSample)
+   //go through ConsumeData rather than Data(), so streamed clips read from disk as they play
+   double clipPos = (playhead + start - mStartSample) * mSample->GetSampleRateRatio();
+   mSample->SetPlayPosition(fmod(clipPos, mSample->LengthInSamples()));
+   gWorkChannelBuffer.SetNumActiveChannels(2);
+   if (mSample->ConsumeData(time + start * gInvSampleRateMs, &gWorkChannelBuffer, end - start, true))
+   {
+      for (int i = start; i < end; ++i)
       {
-         int clipPos = playhead - mStartSample;
-         int samplePos = clipPos % mSample->LengthInSamples();
-         left[i] += mSample->Data()->GetChannel(0)[samplePos];
-         right[i] += mSample->Data()->GetChannel(1)[samplePos];
+         left[i] += gWorkChannelBuffer.GetChannel(0)[i - start];
+         right[i] += gWorkChannelBuffer.GetChannel(1)[i - start];
       }
    }
 }
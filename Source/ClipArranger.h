@@ -80,7 +80,7 @@ private:
    {
    public:
       Clip() {}
-      void Process(float* left, float* right, int bufferSize);
+      void Process(double time, float* left, float* right, int bufferSize);
 
       Sample* mSample{ nullptr };
       int mStartSample{ 0 };
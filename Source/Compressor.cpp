@@ -28,26 +28,15 @@
 #include "SynthGlobals.h"
 #include "Profiler.h"
 #include "UIControlMacros.h"
+#include "MathUtils.h"
 
 namespace
 {
-   static double lin2dB(double lin)
-   {
-      static const double LOG_2_DB = 8.6858896380650365530225783783321; // 20 / ln( 10 )
-      return log(lin) * LOG_2_DB;
-   }
-
-   static double dB2lin(double dB)
-   {
-      static const double DB_2_LOG = 0.11512925464970228420089957273422; // ln( 10 ) / 20
-      return exp(dB * DB_2_LOG);
-   }
-
    const float kMaxLookaheadMs = 50;
 }
 
 Compressor::Compressor()
-: mDelayBuffer(kMaxLookaheadMs * gSampleRateMs)
+: mDelayBuffer(kMaxLookaheadMs * gSampleRateMs + gBufferSize + 1)
 {
    envdB_ = DC_OFFSET;
 }
@@ -85,37 +74,55 @@ void Compressor::ProcessAudio(double time, ChannelBuffer* buffer)
       return;
 
    int bufferSize = buffer->BufferSize();
-   mDelayBuffer.SetNumChannels(buffer->NumActiveChannels());
-
+   int numChannels = buffer->NumActiveChannels();
+   mDelayBuffer.SetNumChannels(numChannels);
+
+   //parameters are read once per block, and ramped to from the previous block's values
+   ComputeSliders(0);
+   BlockParams params;
+   params.mDrive = mDrive;
+   params.mThreshold = mThreshold;
+   params.mSlope = 1.0f / mRatio - 1.0f;
+   params.mMakeup = (-mThreshold * .5f) * -params.mSlope;
+   params.mOutputGain = mDrive * mOutputAdjust;
+   params.mMix = mMix;
+   if (!mHasProcessed)
+   {
+      mLastParams = params;
+      mHasProcessed = true;
+   }
+   const float rampStep = 1.0f / bufferSize;
+   const float driveStep = (params.mDrive - mLastParams.mDrive) * rampStep;
+   const float thresholdStep = (params.mThreshold - mLastParams.mThreshold) * rampStep;
+   const float slopeStep = (params.mSlope - mLastParams.mSlope) * rampStep;
+   const float makeupStep = (params.mMakeup - mLastParams.mMakeup) * rampStep;
+   const float outputGainStep = (params.mOutputGain - mLastParams.mOutputGain) * rampStep;
+   const float mixStep = (params.mMix - mLastParams.mMix) * rampStep;
+
+   //sidechain: peak across channels, converted to dB over threshold
+   float* sidechain = gWorkBuffer;
    for (int i = 0; i < bufferSize; ++i)
+      sidechain[i] = fabsf(buffer->GetChannel(0)[i]);
+   for (int ch = 1; ch < numChannels; ++ch)
    {
-      ComputeSliders(i);
-
-      // create sidechain
-
-      float input = 0;
-      for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
-         input = MAX(input, fabsf(buffer->GetChannel(ch)[i]));
-      input *= mDrive;
-
-      /* if desired, one could use another EnvelopeDetector to smooth
-       * the rectified signal.
-       */
-
-      // convert key to dB
-      input += DC_OFFSET; // add DC offset to avoid log( 0 )
-      mCurrentInputDb = lin2dB(input); // convert linear -> dB
-
-      // threshold
-      double overdB = mCurrentInputDb - mThreshold; // delta over threshold
-      if (overdB < 0.0)
-         overdB = 0.0;
-
-      // attack/release
+      const float* channel = buffer->GetChannel(ch);
+      for (int i = 0; i < bufferSize; ++i)
+         sidechain[i] = MAX(sidechain[i], fabsf(channel[i]));
+   }
+   mCurrentInputDb = MathUtils::FastLin2dB(sidechain[bufferSize - 1] * params.mDrive + DC_OFFSET);
+   for (int i = 0; i < bufferSize; ++i)
+   {
+      float drive = mLastParams.mDrive + driveStep * i;
+      float threshold = mLastParams.mThreshold + thresholdStep * i;
+      float inputDb = MathUtils::FastLin2dB(sidechain[i] * drive + DC_OFFSET); //DC offset avoids log(0)
+      sidechain[i] = MAX(inputDb - threshold, 0.0f);
+   }
 
-      overdB += DC_OFFSET; // add DC offset to avoid denormal
-      mEnv.run(overdB, envdB_); // run attack/release envelope
-      overdB = envdB_ - DC_OFFSET; // subtract DC offset
+   //attack/release, this is the only part that has to run sample by sample
+   for (int i = 0; i < bufferSize; ++i)
+   {
+      mEnv.run(sidechain[i] + DC_OFFSET, envdB_); //DC offset avoids denormals
+      sidechain[i] = envdB_ - DC_OFFSET;
 
       /* REGARDING THE DC OFFSET: In this case, since the offset is added before
        * the attack/release processes, the envelope will never fall below the offset,
@@ -123,21 +130,31 @@ void Compressor::ProcessAudio(double time, ChannelBuffer* buffer)
        * constant gain reduction, we must subtract it from the envelope, yielding
        * a minimum value of 0dB.
        */
+   }
 
-      double invRatio = 1 / mRatio;
-
-      // transfer function
-      double reduction = overdB * (invRatio - 1.0); // gain reduction (dB)
-      double makeup = (-mThreshold * .5) * (1.0 - invRatio);
-      mOutputGain = ofLerp(1, dB2lin(reduction + makeup) * mDrive * mOutputAdjust, mMix);
+   //transfer function, turning the over-threshold envelope into gain
+   float* gain = sidechain;
+   for (int i = 0; i < bufferSize; ++i)
+   {
+      float slope = mLastParams.mSlope + slopeStep * i;
+      float makeup = mLastParams.mMakeup + makeupStep * i;
+      float outputGain = mLastParams.mOutputGain + outputGainStep * i;
+      float mix = mLastParams.mMix + mixStep * i;
+      float reduction = gain[i] * slope; //gain reduction (dB)
+      gain[i] = ofLerp(1, MathUtils::FastdB2Lin(reduction + makeup) * outputGain, mix);
+   }
+   mOutputGain = gain[bufferSize - 1];
 
-      // output gain
-      for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
-      {
-         mDelayBuffer.Write(buffer->GetChannel(ch)[i], ch);
-         buffer->GetChannel(ch)[i] = mDelayBuffer.GetSample(ofClamp(int(mLookahead * gSampleRateMs) + 1, 1, mDelayBuffer.Size() - 1), ch) * mOutputGain; // apply gain reduction to input
-      }
+   //delay the signal by the lookahead, and apply the gain
+   int lookaheadSamples = ofClamp(int(mLookahead * gSampleRateMs), 0, mDelayBuffer.Size() - bufferSize - 1);
+   for (int ch = 0; ch < numChannels; ++ch)
+   {
+      mDelayBuffer.WriteChunk(buffer->GetChannel(ch), bufferSize, ch);
+      mDelayBuffer.ReadChunk(buffer->GetChannel(ch), bufferSize, lookaheadSamples, ch);
+      Mult(buffer->GetChannel(ch), gain, bufferSize);
    }
+
+   mLastParams = params;
 }
 
 void Compressor::DrawModule()
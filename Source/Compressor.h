@@ -136,6 +136,16 @@ private:
    }
    bool Enabled() const override { return mEnabled; }
 
+   struct BlockParams
+   {
+      float mDrive{ 1 };
+      float mThreshold{ 0 };
+      float mSlope{ 0 };
+      float mMakeup{ 0 };
+      float mOutputGain{ 1 };
+      float mMix{ 1 };
+   };
+
    float mMix{ 1 };
    float mDrive{ 1 };
    float mThreshold{ -24 };
@@ -162,6 +172,8 @@ private:
    double envdB_; // over-threshold envelope (dB)
 
    AttRelEnvelope mEnv;
+   BlockParams mLastParams;
+   bool mHasProcessed{ false };
 
    RollingBuffer mDelayBuffer;
 };
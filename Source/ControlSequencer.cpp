@@ -33,6 +33,7 @@ std::list<ControlSequencer*> ControlSequencer::sControlSequencers;
 
 ControlSequencer::ControlSequencer()
 {
+   SetPollRate(kMaxPollRate);
    sControlSequencers.push_back(this);
 }
 
@@ -55,6 +55,7 @@ ControllingSong::ControllingSong()
 , mMute(false)
 , mMuteCheckbox(nullptr)
 {
+   SetPollRate(kMaxPollRate);
 }
 
 void ControllingSong::CreateUIControls()
@@ -135,7 +136,7 @@ void ControllingSong::LoadSong(int index)
    {
       if (i == 0)
       {
-         mSample.Read(ofToDataPath(mSongList["songs"][index]["wavs"][i].asString()).c_str());
+         mSample.Read(ofToDataPath(mSongList["songs"][index]["wavs"][i].asString()).c_str(), false, Sample::ReadType::Stream);
          mSample.SetPlayPosition(0);
       }
       else
@@ -246,7 +247,7 @@ void ControllingSong::DrawModule()
       ofTranslate(10, 50);
       if (mCurrentSongIndex != -1)
          DrawTextNormal(mSongList["songs"][mCurrentSongIndex]["name"].asString(), 0, -10);
-      DrawAudioBuffer(540, 100, mSample.Data(), 0, mSample.LengthInSamples() / mSample.GetSampleRateRatio(), mSample.GetPlayPosition());
+      DrawAudioBuffer(540, 100, mSample.Data(), 0, MIN(mSample.LengthInSamples() / mSample.GetSampleRateRatio(), mSample.GetNumDecodedSamples()), mSample.GetPlayPosition()); //only the decoded head is in Data() while streaming
       ofPopMatrix();
    }
 
@@ -44,6 +44,7 @@ CurveLooper::CurveLooper()
 , mEnvelopeControl(ofVec2f(5, 25), ofVec2f(mWidth - 10, mHeight - 30))
 , mRandomizeButton(nullptr)
 {
+   SetPollRate(kMaxPollRate);
    mEnvelopeControl.SetADSR(&mAdsr);
    mEnvelopeControl.SetViewLength(kAdsrTime);
    mEnvelopeControl.SetFixedLengthMode(true);
@@ -33,6 +33,10 @@
 
 DelayEffect::DelayEffect()
 : mDelayBuffer(DELAY_BUFFER_SIZE)
+, mAmountBuffer(gBufferSize)
+, mDelaySampsBuffer(gBufferSize)
+, mDelayedBuffer(gBufferSize)
+, mDelayWriteBuffer(gBufferSize)
 {
 }
 
@@ -74,9 +78,12 @@ void DelayEffect::ProcessAudio(double time, ChannelBuffer* buffer)
    if (!mEnabled)
       return;
 
-   float bufferSize = buffer->BufferSize();
+   int bufferSize = buffer->BufferSize();
+   assert(bufferSize <= (int)mAmountBuffer.size());
    mDelayBuffer.SetNumChannels(buffer->NumActiveChannels());
 
+   ComputeSliders(0);
+
    if (mInterval != kInterval_None)
    {
       mDelay = TheTransport->GetDuration(mInterval) + .1f; //+1 to avoid perfect sample collision
@@ -84,50 +91,96 @@ void DelayEffect::ProcessAudio(double time, ChannelBuffer* buffer)
    }
 
    mAmountRamp.Start(time, mFeedback, time + 3);
-   for (int i = 0; i < bufferSize; ++i)
-   {
-      mFeedback = mAmountRamp.Value(time);
-
-      ComputeSliders(i);
 
-      float delay = MAX(mDelayRamp.Value(time), GetMinDelayMs());
+   float* amount = mAmountBuffer.data();
+   float* delaySamps = mDelaySampsBuffer.data();
+   mAmountRamp.FillBuffer(time, amount, bufferSize);
+   mDelayRamp.FillBuffer(time, delaySamps, bufferSize);
 
-      float delaySamps = delay / gInvSampleRateMs;
+   const float minDelayMs = GetMinDelayMs();
+   float minDelaySamps = delaySamps[0];
+   float maxDelaySamps = delaySamps[0];
+   for (int i = 0; i < bufferSize; ++i)
+   {
+      float delay = MAX(delaySamps[i], minDelayMs) / gInvSampleRateMs;
       if (mFeedbackModuleMode)
-         delaySamps -= gBufferSize;
-      delaySamps = ofClamp(delaySamps, 0.1f, DELAY_BUFFER_SIZE - 2);
+         delay -= gBufferSize;
+      delaySamps[i] = ofClamp(delay, 0.1f, DELAY_BUFFER_SIZE - 2);
+      minDelaySamps = MIN(minDelaySamps, delaySamps[i]);
+      maxDelaySamps = MAX(maxDelaySamps, delaySamps[i]);
+   }
 
-      int sampsAgoA = int(delaySamps);
-      int sampsAgoB = sampsAgoA + 1;
+   const float invert = mInvert ? -1 : 1;
 
+   if (minDelaySamps >= bufferSize) //every read comes from before this block, so read the whole block at once
+   {
+      float* delayed = mDelayedBuffer.data();
+      float* delayWrite = mDelayWriteBuffer.data();
       for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
       {
-         float sample = mDelayBuffer.GetSample(sampsAgoA, ch);
-         float nextSample = mDelayBuffer.GetSample(sampsAgoB, ch);
-         float a = delaySamps - sampsAgoA;
-         float delayedSample = (1 - a) * sample + a * nextSample; //interpolate
+         if (minDelaySamps == maxDelaySamps)
+            mDelayBuffer.ReadChunkDelayed(delayed, bufferSize, delaySamps[0], ch);
+         else
+            mDelayBuffer.ReadChunkDelayed(delayed, bufferSize, delaySamps, ch);
+
+         float* channel = buffer->GetChannel(ch);
+         for (int i = 0; i < bufferSize; ++i)
+         {
+            float in = channel[i];
+
+            float delayInput = delayed[i] * amount[i] * invert;
+            JUCE_UNDENORMALISE(delayInput);
+            if (delayInput == delayInput) //filter NaNs
+               channel[i] += delayInput;
+
+            if (!mAcceptInput)
+               delayWrite[i] = delayInput;
+            else if (mEcho) //continuous feedback
+               delayWrite[i] = channel[i];
+            else //single delay
+               delayWrite[i] = in;
+
+            if (!mDry)
+               channel[i] -= in;
+         }
+
+         mDelayBuffer.WriteChunk(delayWrite, bufferSize, ch);
+      }
+   }
+   else //delay is shorter than the block, so feedback has to be handled sample by sample
+   {
+      for (int i = 0; i < bufferSize; ++i)
+      {
+         int sampsAgoA = int(delaySamps[i]);
+         int sampsAgoB = sampsAgoA + 1;
 
-         float in = buffer->GetChannel(ch)[i];
+         for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+         {
+            float sample = mDelayBuffer.GetSample(sampsAgoA, ch);
+            float nextSample = mDelayBuffer.GetSample(sampsAgoB, ch);
+            float a = delaySamps[i] - sampsAgoA;
+            float delayedSample = (1 - a) * sample + a * nextSample; //interpolate
 
-         if (!mEcho && mAcceptInput) //single delay, no continuous feedback so do it pre
-            mDelayBuffer.Write(buffer->GetChannel(ch)[i], ch);
+            float in = buffer->GetChannel(ch)[i];
 
-         float delayInput = delayedSample * mFeedback * (mInvert ? -1 : 1);
-         JUCE_UNDENORMALISE(delayInput);
-         if (delayInput == delayInput) //filter NaNs
-            buffer->GetChannel(ch)[i] += delayInput;
+            if (!mEcho && mAcceptInput) //single delay, no continuous feedback so do it pre
+               mDelayBuffer.Write(buffer->GetChannel(ch)[i], ch);
 
-         if (mEcho && mAcceptInput) //continuous feedback so do it post
-            mDelayBuffer.Write(buffer->GetChannel(ch)[i], ch);
+            float delayInput = delayedSample * amount[i] * invert;
+            JUCE_UNDENORMALISE(delayInput);
+            if (delayInput == delayInput) //filter NaNs
+               buffer->GetChannel(ch)[i] += delayInput;
 
-         if (!mAcceptInput)
-            mDelayBuffer.Write(delayInput, ch);
+            if (mEcho && mAcceptInput) //continuous feedback so do it post
+               mDelayBuffer.Write(buffer->GetChannel(ch)[i], ch);
 
-         if (!mDry)
-            buffer->GetChannel(ch)[i] -= in;
-      }
+            if (!mAcceptInput)
+               mDelayBuffer.Write(delayInput, ch);
 
-      time += gInvSampleRateMs;
+            if (!mDry)
+               buffer->GetChannel(ch)[i] -= in;
+         }
+      }
    }
 }
 
@@ -27,6 +27,7 @@
 #define __modularSynth__DelayEffect__
 
 #include <iostream>
+#include <vector>
 #include "IAudioEffect.h"
 #include "RollingBuffer.h"
 #include "Slider.h"
@@ -93,6 +94,10 @@ private:
    Checkbox* mShortTimeCheckbox{ nullptr };
    Ramp mDelayRamp;
    Ramp mAmountRamp;
+   std::vector<float> mAmountBuffer;
+   std::vector<float> mDelaySampsBuffer;
+   std::vector<float> mDelayedBuffer;
+   std::vector<float> mDelayWriteBuffer;
    bool mAcceptInput{ true };
    bool mDry{ true };
    bool mInvert{ false };
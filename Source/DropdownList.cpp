@@ -28,6 +28,7 @@
 #include "FileStream.h"
 #include "ModularSynth.h"
 #include "Push2Control.h"
+#include "ModuleRenderCache.h"
 
 DropdownList::DropdownList(IDropdownListener* owner, const char* name, int x, int y, int* var, float width)
 : mWidth(35)
@@ -466,6 +467,13 @@ std::string DropdownList::GetDisplayValue(float val) const
       return mUnknownItemString.c_str();
 }
 
+size_t DropdownList::GetRenderHash()
+{
+   size_t hash = IUIControl::GetRenderHash();
+   HashCombine(hash, GetDisplayValue(GetValue()));
+   return hash;
+}
+
 void DropdownList::CalcSliderVal()
 {
    int itemIndex = FindItemIndex(*mVar);
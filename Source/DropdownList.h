@@ -137,6 +137,7 @@ public:
    float GetMidiValue() const override;
    int GetNumValues() override { return (int)mElements.size(); }
    std::string GetDisplayValue(float val) const override;
+   size_t GetRenderHash() override;
    bool InvertScrollDirection() override { return true; }
    void Increment(float amount) override;
    void Poll() override;
@@ -64,6 +64,7 @@ DrumPlayer::DrumPlayer()
 , mNoteRepeat(false)
 , mQuantizeInterval(kInterval_None)
 {
+   SetPollRate(kMaxPollRate);
 
    ReadKits();
 
@@ -263,7 +264,7 @@ void DrumPlayer::LoadKit(int kit)
       LoadSampleLock();
       for (int i = 0; i < NUM_DRUM_HITS; ++i)
       {
-         mDrumHits[i].mSample.Read(mKits[kit].mSampleFiles[i].c_str());
+         mDrumHits[i].mSample.Read(mKits[kit].mSampleFiles[i].c_str(), false, Sample::ReadType::Async);
          mDrumHits[i].mLinkId = mKits[kit].mLinkIds[i];
          mDrumHits[i].mVol = mKits[kit].mVols[i];
          mDrumHits[i].mSpeed = mKits[kit].mSpeeds[i];
@@ -417,7 +418,7 @@ bool DrumPlayer::DrumHit::Process(double time, float speed, float vol, ChannelBu
    {
       float sampleSpeed = speed;
       if (mPitchBend != nullptr)
-         sampleSpeed *= ofMap(mPitchBend->GetValue(i), -.5f, .5f, 0, 2);
+         sampleSpeed *= ofMap(mPitchBend->GetBlockValue(i), -.5f, .5f, 0, 2);
 
       for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
          gWorkBuffer[ch] = 0;
@@ -569,7 +570,7 @@ void DrumPlayer::FilesDropped(std::vector<std::string> files, int x, int y)
             if (sampleIdx != -1)
             {
                LoadSampleLock();
-               mDrumHits[sampleIdx].mSample.Read(files[i].c_str());
+               mDrumHits[sampleIdx].mSample.Read(files[i].c_str(), false, Sample::ReadType::Async);
                LoadSampleUnlock();
                mDrumHits[sampleIdx].mLinkId = -1;
                mDrumHits[sampleIdx].mVol = 1;
@@ -1145,6 +1146,7 @@ void DrumPlayer::DrumHit::LoadNextSample(int direction)
 
 void DrumPlayer::DrumHit::GrabSample()
 {
+   mSample.FinishLoading();
    TheSynth->GrabSample(mSample.Data(), mSample.Name());
 }
 
@@ -175,7 +175,7 @@ private:
       , mVizBuffer(nullptr)
       , mPatchCableSource(nullptr)
       {
-         mVizBuffer = new RollingBuffer(VIZ_BUFFER_SECONDS * gSampleRate);
+         mVizBuffer = new VizBuffer(VIZ_BUFFER_SECONDS * gSampleRate);
          mPatchCableSource = new PatchCableSource(owner, kConnectionType_Audio);
 
          mPatchCableSource->SetOverrideVizBuffer(mVizBuffer);
@@ -194,7 +194,7 @@ private:
       }
       DrumPlayer* mDrumPlayer;
       int mHitIndex;
-      RollingBuffer* mVizBuffer;
+      VizBuffer* mVizBuffer;
       PatchCableSource* mPatchCableSource;
    };
 
@@ -144,7 +144,7 @@ private:
       , mVizBuffer(nullptr)
       , mPatchCableSource(nullptr)
       {
-         mVizBuffer = new RollingBuffer(VIZ_BUFFER_SECONDS * gSampleRate);
+         mVizBuffer = new VizBuffer(VIZ_BUFFER_SECONDS * gSampleRate);
          mPatchCableSource = new PatchCableSource(owner->mParent, kConnectionType_Audio);
 
          mPatchCableSource->SetOverrideVizBuffer(mVizBuffer);
@@ -158,7 +158,7 @@ private:
          delete mVizBuffer;
       }
       DrumSynthHit* mHit;
-      RollingBuffer* mVizBuffer;
+      VizBuffer* mVizBuffer;
       PatchCableSource* mPatchCableSource;
    };
 
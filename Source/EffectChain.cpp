@@ -35,6 +35,7 @@ EffectChain::EffectChain()
 : IAudioProcessor(gBufferSize)
 , mDryBuffer(gBufferSize)
 {
+   SetPollRate(kMaxPollRate);
 }
 
 EffectChain::~EffectChain()
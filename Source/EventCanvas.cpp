@@ -139,7 +139,8 @@ void EventCanvas::OnTransportAdvanced(float amount)
    if (!mEnabled)
       return;
 
-   for (auto* canvasElement : mCanvas->GetElements())
+   mCanvas->FillElementsInRange(mPreviousPosition, curPos, mElementsInRange);
+   for (auto* canvasElement : mElementsInRange)
    {
       float elementStart = canvasElement->GetStart();
       bool startPassed = (elementStart > mPreviousPosition && elementStart <= curPos) ||
@@ -362,6 +363,7 @@ void EventCanvas::ButtonClicked(ClickButton* button)
             element->mOffset = 0;
          }
       }
+      mCanvas->MarkElementsMoved();
    }
 }
 
@@ -101,6 +101,7 @@ private:
    bool mRecord;
    Checkbox* mRecordCheckbox;
    float mPreviousPosition;
+   std::vector<CanvasElement*> mElementsInRange;
 
    struct ControlConnection
    {
@@ -52,6 +52,8 @@ bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
    if (IsDone(time))
       return false;
 
+   UpdateModulationBlocks();
+
    int bufferSize = out->BufferSize();
    int channels = out->NumActiveChannels();
    double sampleIncrementMs = gInvSampleRateMs;
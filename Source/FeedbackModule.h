@@ -70,7 +70,7 @@ private:
 
    IAudioReceiver* mFeedbackTarget{ nullptr };
    PatchCableSource* mFeedbackTargetCable{ nullptr };
-   RollingBuffer mFeedbackVizBuffer;
+   VizBuffer mFeedbackVizBuffer;
    float mSignalLimit{ 1 };
    double mGainScale[ChannelBuffer::kMaxNumChannels];
    FloatSlider* mSignalLimitSlider{ nullptr };
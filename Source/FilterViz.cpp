@@ -32,6 +32,7 @@
 FilterViz::FilterViz()
 : mNeedUpdate(true)
 {
+   SetPollRate(30);
    mImpulseBuffer = new float[FILTER_VIZ_BINS];
    mFFTOutReal = new float[FILTER_VIZ_BINS];
    mFFTOutImag = new float[FILTER_VIZ_BINS];
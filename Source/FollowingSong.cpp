@@ -54,7 +54,7 @@ void FollowingSong::LoadSample(const char* file)
 {
    mLoadingSong = true;
    mLoadSongMutex.lock();
-   mSample.Read(file);
+   mSample.Read(file, false, Sample::ReadType::Stream);
    mLoadSongMutex.unlock();
    mLoadingSong = false;
 }
@@ -122,7 +122,7 @@ void FollowingSong::DrawModule()
    ofPushMatrix();
    ofTranslate(10, 20);
    DrawTextNormal(mSample.Name(), 100, -10);
-   DrawAudioBuffer(540, 100, mSample.Data(), 0, mSample.LengthInSamples() / mSample.GetSampleRateRatio(), mSample.GetPlayPosition());
+   DrawAudioBuffer(540, 100, mSample.Data(), 0, MIN(mSample.LengthInSamples() / mSample.GetSampleRateRatio(), mSample.GetNumDecodedSamples()), mSample.GetPlayPosition()); //only the decoded head is in Data() while streaming
    ofPopMatrix();
 
    ofPushStyle();
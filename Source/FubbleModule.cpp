@@ -59,6 +59,7 @@ FubbleModule::FubbleModule()
 , mPerlinScale(1)
 , mPerlinSpeed(1)
 {
+   SetPollRate(kMaxPollRate);
    UpdatePerlinSeed();
 }
 
@@ -50,6 +50,7 @@ public:
 private:
    //IDrawableModule
    void DrawModule() override;
+   bool CanCacheDrawing() const override { return true; }
    void GetModuleDimensions(float& width, float& height) override
    {
       width = 120;
@@ -32,6 +32,7 @@
 
 GlobalControls::GlobalControls()
 {
+   SetPollRate(kMaxPollRate);
 }
 
 GlobalControls::~GlobalControls()
@@ -31,6 +31,7 @@
 
 GridSliders::GridSliders()
 {
+   SetPollRate(kMaxPollRate);
 }
 
 void GridSliders::Init()
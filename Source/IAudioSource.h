@@ -26,7 +26,7 @@
 #ifndef modularSynth_IAudioSource_h
 #define modularSynth_IAudioSource_h
 
-#include "RollingBuffer.h"
+#include "VizBuffer.h"
 #include "SynthGlobals.h"
 #include "IPatchable.h"
 
@@ -44,13 +44,13 @@ public:
    virtual void Process(double time) = 0;
    IAudioReceiver* GetTarget(int index = 0);
    virtual int GetNumTargets() { return 1; }
-   RollingBuffer* GetVizBuffer() { return &mVizBuffer; }
+   VizBuffer* GetVizBuffer() { return &mVizBuffer; }
 
 protected:
    void SyncOutputBuffer(int numChannels);
 
 private:
-   RollingBuffer mVizBuffer;
+   VizBuffer mVizBuffer;
 };
 
 #endif
@@ -161,7 +161,16 @@ void IDrawableModule::Init()
 
 void IDrawableModule::BasePoll()
 {
-   Poll();
+   if (mPollRate > 0)
+   {
+      const double kTimerSlackMs = 4; //so we don't skip a poll because a timer tick came in a little early
+      double time = juce::Time::getMillisecondCounterHiRes();
+      if (mPollRate >= kMaxPollRate || time - mLastPollTime >= 1000.0 / mPollRate - kTimerSlackMs)
+      {
+         mLastPollTime = time;
+         Poll();
+      }
+   }
    for (int i = 0; i < mUIControls.size(); ++i)
       mUIControls[i]->Poll();
    for (int i = 0; i < mChildren.size(); ++i)
@@ -187,24 +196,17 @@ bool IDrawableModule::IsVisible()
    return IsWithinRect(TheSynth->GetDrawRect());
 }
 
-void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleBarHeight, float& highlight)
+float IDrawableModule::GetActivityHighlight()
 {
-   titleBarHeight = mTitleBarHeight;
-   if (!HasTitleBar())
-      titleBarHeight = 0;
-
-   ofTranslate(mX, mY, 0);
-
-   ofColor color = GetColor(mModuleType);
-
-   highlight = 0;
+   float highlight = 0;
 
    if (Enabled())
    {
       IAudioSource* audioSource = dynamic_cast<IAudioSource*>(this);
-      if (audioSource)
+      if (audioSource && UserPrefs.draw_module_highlights.Get() && IsVisible())
       {
-         RollingBuffer* vizBuff = audioSource->GetVizBuffer();
+         VizBuffer* vizBuff = audioSource->GetVizBuffer();
+         vizBuff->Watch();
          int numSamples = std::min(500, vizBuff->Size());
          float sample;
          float mag = 0;
@@ -222,8 +224,7 @@ void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleB
          mag *= 3;
          mag = ofClamp(mag, 0, 1);
 
-         if (UserPrefs.draw_module_highlights.Get())
-            highlight = mag * .15f;
+         highlight = mag * .15f;
       }
 
       if (GetPatchCableSource() != nullptr)
@@ -234,6 +235,21 @@ void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleB
       }
    }
 
+   return highlight;
+}
+
+void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleBarHeight, float& highlight)
+{
+   titleBarHeight = mTitleBarHeight;
+   if (!HasTitleBar())
+      titleBarHeight = 0;
+
+   ofTranslate(mX, mY, 0);
+
+   ofColor color = GetColor(mModuleType);
+
+   highlight = GetActivityHighlight();
+
    const bool kUseDropshadow = false;
    if (kUseDropshadow && GetParent() == nullptr && GetModuleType() != kModuleType_Other)
    {
@@ -389,6 +405,18 @@ void IDrawableModule::Render()
    float w, h;
    GetDimensions(w, h);
 
+   if (!mRenderCache.Draw())
+      RenderContents(w, h);
+
+   for (auto source : mPatchCableSources)
+   {
+      source->UpdatePosition(false);
+      source->DrawSource();
+   }
+}
+
+void IDrawableModule::RenderContents(float w, float h)
+{
    ofPushMatrix();
    ofPushStyle();
 
@@ -449,12 +477,53 @@ void IDrawableModule::Render()
 
    ofPopMatrix();
    ofPopStyle();
+}
 
-   for (auto source : mPatchCableSources)
+//a hash of everything RenderContents() depends on, so ModuleRenderCache can tell when a cached image is stale.
+//returns zero when the module is in a state that needs to be drawn live
+size_t IDrawableModule::GetRenderHash()
+{
+   if (!ShouldClipContents() || !mUIGrids.empty() || mHoveringOverResizeHandle || GetBeaconAmount() > 0 || GetActivityHighlight() > 0)
+      return 0;
+
+   if (PatchCable::sActivePatchCable != nullptr || TheSynth->GetHeldSample() != nullptr || !TheSynth->GetGroupSelectedModules().empty())
+      return 0;
+
+   if (ModuleRenderCache::GetFocusedModule() == this)
+      return 0;
+   for (IClickable* parent = this; parent != nullptr; parent = parent->GetParent())
    {
-      source->UpdatePosition(false);
-      source->DrawSource();
+      if (parent == ModuleRenderCache::GetHoveredModule())
+         return 0;
    }
+
+   float w, h;
+   GetDimensions(w, h);
+   ofColor color = GetColor(mModuleType);
+
+   size_t hash = 0;
+   HashCombine(hash, w);
+   HashCombine(hash, h);
+   HashCombine(hash, mMinimizeAnimation);
+   HashCombine(hash, IsVisible());
+   HashCombine(hash, Enabled());
+   HashCombine(hash, GetTitleLabel());
+   HashCombine(hash, color.r * 65536 + color.g * 256 + color.b);
+   HashCombine(hash, TheSaveDataPanel->GetModule() == this);
+   HashCombine(hash, TheSynth->ShouldAccentuateActiveModules());
+
+   for (auto* control : mUIControls)
+      HashCombine(hash, control->GetRenderHash());
+
+   for (auto* child : mChildren)
+   {
+      size_t childHash = child->CanCacheDrawing() ? child->GetRenderHash() : 0;
+      if (childHash == 0)
+         return 0;
+      HashCombine(hash, childHash);
+   }
+
+   return hash != 0 ? hash : 1;
 }
 
 void IDrawableModule::RenderUnclipped()
@@ -30,6 +30,7 @@
 #include "IPollable.h"
 #include "ModuleSaveData.h"
 #include "IPatchable.h"
+#include "ModuleRenderCache.h"
 
 class Checkbox;
 class IUIControl;
@@ -72,11 +73,13 @@ public:
    static bool CanCreate() { return true; }
 
    void Render() override;
+   void RenderContents(float width, float height);
    void RenderUnclipped();
    virtual void PostRender() {}
    void DrawFrame(float width, float height, bool drawModule, float& titleBarHeight, float& highlight);
    void DrawPatchCables(bool parentMinimized);
    bool CheckNeedsDraw() override;
+   size_t GetRenderHash();
    virtual bool AlwaysOnTop() { return false; }
    void ToggleMinimized();
    void SetMinimized(bool minimized)
@@ -146,6 +149,7 @@ public:
    void MarkAsDeleted() { mDeleted = true; }
    bool IsDeleted() const { return mDeleted; }
    virtual bool ShouldClipContents() { return true; }
+   virtual bool CanCacheDrawing() const { return false; } //override to return true if DrawModule() only depends on the state of the module's controls
    bool CanReceiveAudio() { return mCanReceiveAudio; }
    bool CanReceiveNotes() { return mCanReceiveNotes; }
    bool CanReceivePulses() { return mCanReceivePulses; }
@@ -195,6 +199,9 @@ public:
 
 protected:
    virtual void Poll() override {}
+   //Poll() is only called for modules that ask for it, at up to this many times a second
+   void SetPollRate(int timesPerSecond) { mPollRate = timesPerSecond; }
+   static constexpr int kMaxPollRate = 60;
    virtual void OnClicked(int x, int y, bool right) override;
    virtual bool MouseMoved(float x, float y) override;
 
@@ -209,6 +216,7 @@ private:
    virtual void DrawModuleUnclipped() {}
    virtual bool Enabled() const { return true; }
    float GetMinimizedWidth();
+   float GetActivityHighlight();
    PatchCableOld GetPatchCableOld(IClickable* target);
 
    std::vector<IUIControl*> mUIControls;
@@ -233,11 +241,15 @@ private:
    bool mCanReceiveAudio;
    bool mCanReceiveNotes;
    bool mCanReceivePulses;
+   int mPollRate{ 0 };
+   double mLastPollTime{ 0 };
 
    ofMutex mSliderMutex;
 
    PatchCableSource* mMainPatchCableSource;
    std::vector<PatchCableSource*> mPatchCableSources;
+
+   ModuleRenderCache mRenderCache{ this };
 };
 
 #endif
@@ -41,7 +41,11 @@ public:
    virtual ~IMidiVoice() {}
    virtual void ClearVoice() = 0;
    void SetPitch(float pitch) { mPitch = ofClamp(pitch, 0, 127); }
-   void SetModulators(ModulationParameters modulators) { mModulators = modulators; }
+   void SetModulators(ModulationParameters modulators)
+   {
+      mModulators = modulators;
+      mModulationBlockTime = -1;
+   }
    virtual void Start(double time, float amount) = 0;
    virtual void Stop(double time) = 0;
    virtual bool Process(double time, ChannelBuffer* out, int oversampling) = 0;
@@ -58,14 +62,35 @@ public:
       return mPan;
    }
 
-   float GetPitch(int samplesIn) { return mPitch + (mModulators.pitchBend ? mModulators.pitchBend->GetValue(samplesIn) : 0); }
-   float GetModWheel(int samplesIn) { return mModulators.modWheel ? mModulators.modWheel->GetValue(samplesIn) : 0.5f; }
-   float GetPressure(int samplesIn) { return mModulators.pressure ? mModulators.pressure->GetValue(samplesIn) : 0.5f; }
+   //call at the top of Process(), so the getters below can index straight into this buffer's modulation blocks
+   //rather than asking the chains for them on every sample
+   void UpdateModulationBlocks()
+   {
+      mPitchBendBlock = mModulators.pitchBend ? mModulators.pitchBend->GetBlock() : nullptr;
+      mModWheelBlock = mModulators.modWheel ? mModulators.modWheel->GetBlock() : nullptr;
+      mPressureBlock = mModulators.pressure ? mModulators.pressure->GetBlock() : nullptr;
+      mModulationBlockTime = gTime;
+   }
+
+   float GetPitch(int samplesIn) { return mPitch + (mModulators.pitchBend ? ReadModulation(mModulators.pitchBend, mPitchBendBlock, samplesIn) : 0); }
+   float GetModWheel(int samplesIn) { return mModulators.modWheel ? ReadModulation(mModulators.modWheel, mModWheelBlock, samplesIn) : 0.5f; }
+   float GetPressure(int samplesIn) { return mModulators.pressure ? ReadModulation(mModulators.pressure, mPressureBlock, samplesIn) : 0.5f; }
 
 private:
+   float ReadModulation(ModulationChain* chain, const float* block, int samplesIn)
+   {
+      if (mModulationBlockTime == gTime && samplesIn >= 0 && samplesIn < gBufferSize)
+         return block[samplesIn];
+      return chain->GetBlockValue(samplesIn); //outside of Process(), or past the end of the buffer
+   }
+
    float mPitch;
    float mPan;
    ModulationParameters mModulators;
+   const float* mPitchBendBlock{ nullptr };
+   const float* mModWheelBlock{ nullptr };
+   const float* mPressureBlock{ nullptr };
+   double mModulationBlockTime{ -1 };
 };
 
 #endif
@@ -31,54 +31,51 @@
 NoteInputBuffer::NoteInputBuffer(INoteReceiver* receiver)
 : mReceiver(receiver)
 {
-   for (int i = 0; i < kBufferSize; ++i)
-      mBuffer[i].time = -1;
+   mDueNotes.reserve(mQueue.GetCapacity());
 }
 
 void NoteInputBuffer::Process(double time)
 {
    PROFILER(NoteInputBuffer);
 
+   NoteInputElement incoming;
+   while (mIncomingNotes.consume(incoming))
+      mQueue.Push(incoming.time, incoming, incoming.velocity == 0 ? 0 : 1);
+
+   //take out everything that lands in this frame first, since playing a note can queue more
+   mDueNotes.clear();
+   while (!mQueue.IsEmpty() && IsTimeWithinFrame(mQueue.GetNextTime()))
+   {
+      mDueNotes.push_back(mQueue.GetNext());
+      mQueue.PopNext();
+   }
+
    //process note offs first
-   for (int i = 0; i < kBufferSize; ++i)
+   for (const NoteInputElement& element : mDueNotes)
    {
-      if (mBuffer[i].time != -1 && mBuffer[i].velocity == 0 &&
-          IsTimeWithinFrame(mBuffer[i].time))
-      {
-         NoteInputElement& element = mBuffer[i];
+      if (element.velocity == 0)
          mReceiver->PlayNote(element.time, element.pitch, element.velocity, element.voiceIdx, element.modulation);
-         mBuffer[i].time = -1;
-      }
    }
 
    //now process note ons
-   for (int i = 0; i < kBufferSize; ++i)
+   for (const NoteInputElement& element : mDueNotes)
    {
-      if (mBuffer[i].time != -1 && mBuffer[i].velocity != 0 &&
-          IsTimeWithinFrame(mBuffer[i].time))
-      {
-         NoteInputElement& element = mBuffer[i];
+      if (element.velocity != 0)
          mReceiver->PlayNote(element.time, element.pitch, element.velocity, element.voiceIdx, element.modulation);
-         mBuffer[i].time = -1;
-      }
    }
 }
 
 void NoteInputBuffer::QueueNote(double time, int pitch, float velocity, int voiceIdx, ModulationParameters modulation)
 {
-   for (int i = 0; i < kBufferSize; ++i)
-   {
-      if (mBuffer[i].time == -1)
-      {
-         mBuffer[i].time = time;
-         NoteInputElement& element = mBuffer[i];
-         element.pitch = pitch;
-         element.velocity = velocity;
-         element.voiceIdx = voiceIdx;
-         element.modulation = modulation;
-         break;
-      }
-   }
+   NoteInputElement element;
+   element.time = time;
+   element.pitch = pitch;
+   element.velocity = velocity;
+   element.voiceIdx = voiceIdx;
+   element.modulation = modulation;
+
+   std::lock_guard<ofMutex> lock(mIncomingNotesWriteMutex);
+   mIncomingNotes.produce(element); //if the ring is full the audio thread isn't keeping up, so the note is dropped
 }
 
 //static
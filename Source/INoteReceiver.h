@@ -28,31 +28,40 @@
 
 #include "OpenFrameworksPort.h"
 #include "ModulationChain.h"
+#include "TimedEventQueue.h"
+#include "LockFreeQueue.h"
 
 namespace juce
 {
    class MidiMessage;
 }
 
+struct NoteInputElement
+{
+   double time{ 0 };
+   int pitch{ 0 };
+   float velocity{ 0 };
+   int voiceIdx{ -1 };
+   ModulationParameters modulation;
+};
+
 class INoteReceiver
 {
 public:
    virtual ~INoteReceiver() {}
    virtual void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) = 0;
+   //a block of notes in time order, with every pitch in range, from NoteOutput::PlayNoteBlock(). note effects override
+   //this to transform the whole list and pass it on as one block, rather than recursing through PlayNote() for each note
+   virtual void PlayNoteBlock(const std::vector<NoteInputElement>& notes)
+   {
+      for (const NoteInputElement& note : notes)
+         PlayNote(note.time, note.pitch, note.velocity, note.voiceIdx, note.modulation);
+   }
    virtual void SendPressure(int pitch, int pressure) {}
    virtual void SendCC(int control, int value, int voiceIdx = -1) = 0;
    virtual void SendMidi(const juce::MidiMessage& message) {}
 };
 
-struct NoteInputElement
-{
-   double time{ 0 };
-   int pitch{ 0 };
-   float velocity{ 0 };
-   int voiceIdx{ -1 };
-   ModulationParameters modulation;
-};
-
 class NoteInputBuffer
 {
 public:
@@ -62,8 +71,12 @@ public:
    static bool IsTimeWithinFrame(double time);
 
 private:
-   static const int kBufferSize = 50;
-   NoteInputElement mBuffer[kBufferSize];
+   //QueueNote() can come in from any thread, so notes land in mIncomingNotes first, and Process() moves them into mQueue,
+   //which only the audio thread touches
+   LockFreeRingQueue<NoteInputElement, 256> mIncomingNotes;
+   ofMutex mIncomingNotesWriteMutex; //only the writers lock this
+   TimedEventQueue<NoteInputElement> mQueue{ 512 };
+   std::vector<NoteInputElement> mDueNotes; //reserved to the queue's capacity, since that's the most that can come due at once
    INoteReceiver* mReceiver;
 };
 
@@ -37,36 +37,70 @@ void NoteOutput::PlayNote(double time, int pitch, int velocity, int voiceIdx, Mo
    PlayNoteInternal(time, pitch, velocity, voiceIdx, modulation);
 }
 
-void NoteOutput::PlayNoteInternal(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation)
+bool NoteOutput::PushStack()
 {
    const int kMaxDepth = 100;
    if (mStackDepth > kMaxDepth)
    {
       TheSynth->LogEvent("note chain hit max stack depth", kLogEventType_Error);
-      return; //avoid stack overflow
+      return false; //avoid stack overflow
    }
    ++mStackDepth;
+   return true;
+}
+
+void NoteOutput::UpdateHeldNote(double time, int pitch, int velocity)
+{
+   bool wasHeld = mNotes[pitch];
+   if (velocity > 0)
+   {
+      mNoteOnTimes[pitch] = time;
+      mNotes[pitch] = true;
+   }
+   else
+   {
+      if (time > mNoteOnTimes[pitch])
+         mNotes[pitch] = false;
+   }
+
+   if (mNotes[pitch] != wasHeld)
+      mNumHeldNotes += mNotes[pitch] ? 1 : -1;
+}
+
+void NoteOutput::PlayNoteInternal(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation)
+{
+   if (!PushStack())
+      return;
 
    if (pitch >= 0 && pitch <= 127)
    {
       for (auto noteReceiver : mNoteSource->GetPatchCableSource()->GetNoteReceivers())
          noteReceiver->PlayNote(time, pitch, velocity, voiceIdx, modulation);
 
-      if (velocity > 0)
-      {
-         mNoteOnTimes[pitch] = time;
-         mNotes[pitch] = true;
-      }
-      else
-      {
-         if (time > mNoteOnTimes[pitch])
-            mNotes[pitch] = false;
-      }
+      UpdateHeldNote(time, pitch, velocity);
 
       mNoteSource->GetPatchCableSource()->AddHistoryEvent(time, HasHeldNotes());
    }
 }
 
+//hands the whole block to each receiver in turn, like an audio buffer going down a chain, so a chain of note effects
+//that handle blocks costs one call per effect rather than one per note. pitches must already be in range
+void NoteOutput::PlayNoteBlock(const std::vector<NoteInputElement>& notes)
+{
+   if (notes.empty() || !PushStack())
+      return;
+
+   PatchCableSource* cable = mNoteSource->GetPatchCableSource();
+   for (auto noteReceiver : cable->GetNoteReceivers())
+      noteReceiver->PlayNoteBlock(notes);
+
+   for (const NoteInputElement& note : notes)
+   {
+      UpdateHeldNote(note.time, note.pitch, note.velocity);
+      cable->AddHistoryEvent(note.time, HasHeldNotes());
+   }
+}
+
 void NoteOutput::SendPressure(int pitch, int pressure)
 {
    for (auto noteReceiver : mNoteSource->GetPatchCableSource()->GetNoteReceivers())
@@ -85,16 +119,6 @@ void NoteOutput::SendMidi(const juce::MidiMessage& message)
       noteReceiver->SendMidi(message);
 }
 
-bool NoteOutput::HasHeldNotes()
-{
-   for (int i = 0; i < 128; ++i)
-   {
-      if (mNotes[i])
-         return true;
-   }
-   return false;
-}
-
 std::list<int> NoteOutput::GetHeldNotesList()
 {
    std::list<int> notes;
@@ -123,6 +147,7 @@ void NoteOutput::Flush(double time)
          mNotes[i] = false;
       }
    }
+   mNumHeldNotes = 0;
 
    if (flushed)
       mNoteSource->GetPatchCableSource()->AddHistoryEvent(time, false);
@@ -153,6 +178,17 @@ void INoteSource::PlayNoteOutput(double time, int pitch, int velocity, int voice
    mInNoteOutput = false;
 }
 
+void INoteSource::PlayNoteOutputBlock(const std::vector<NoteInputElement>& notes)
+{
+   PROFILER(INoteSourcePlayOutputBlock);
+
+   if (!mInNoteOutput)
+      mNoteOutput.ResetStackDepth();
+   mInNoteOutput = true;
+   mNoteOutput.PlayNoteBlock(notes);
+   mInNoteOutput = false;
+}
+
 void INoteSource::SendCCOutput(int control, int value, int voiceIdx /*=-1*/)
 {
    mNoteOutput.SendCC(control, value, voiceIdx);
@@ -53,15 +53,20 @@ public:
    void SendMidi(const juce::MidiMessage& message) override;
 
    void PlayNoteInternal(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters());
+   void PlayNoteBlock(const std::vector<NoteInputElement>& notes);
 
    void ResetStackDepth() { mStackDepth = 0; }
    bool* GetNotes() { return mNotes; }
-   bool HasHeldNotes();
+   bool HasHeldNotes() const { return mNumHeldNotes > 0; }
    std::list<int> GetHeldNotesList();
 
 private:
+   bool PushStack();
+   void UpdateHeldNote(double time, int pitch, int velocity);
+
    bool mNotes[128]{};
    double mNoteOnTimes[128]{};
+   int mNumHeldNotes{ 0 };
    INoteSource* mNoteSource;
    int mStackDepth;
 };
@@ -75,6 +80,7 @@ public:
    {}
    virtual ~INoteSource() {}
    void PlayNoteOutput(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters());
+   void PlayNoteOutputBlock(const std::vector<NoteInputElement>& notes);
    void SendCCOutput(int control, int value, int voiceIdx = -1);
 
    //IPatchable
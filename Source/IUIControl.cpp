@@ -30,6 +30,7 @@
 #include "PatchCable.h"
 #include "Push2Control.h"
 #include "TextEntry.h"
+#include "ModuleRenderCache.h"
 
 //static
 IUIControl* IUIControl::sLastHoveredUIControl = nullptr;
@@ -151,6 +152,20 @@ void IUIControl::DrawPatchCableHover()
    }
 }
 
+size_t IUIControl::GetRenderHash()
+{
+   size_t hash = 0;
+   HashCombine(hash, IsShowing());
+   HashCombine(hash, mX);
+   HashCombine(hash, mY);
+   HashCombine(hash, GetValue());
+   HashCombine(hash, GetBeaconAmount());
+   HashCombine(hash, IsPreset());
+   HashCombine(hash, mRemoteControlCount > 0 && TheSynth->InMidiMapMode());
+   HashCombine(hash, gBindToUIControl == this);
+   return hash;
+}
+
 bool IUIControl::CanBeTargetedBy(PatchCableSource* source) const
 {
    return source->GetConnectionType() == kConnectionType_Modulator || source->GetConnectionType() == kConnectionType_UIControl;
@@ -93,6 +93,7 @@ public:
    virtual bool IsButtonControl() { return false; }
    virtual bool IsMouseDown() const { return false; }
    virtual bool IsTextEntry() const { return false; }
+   virtual size_t GetRenderHash(); //see IDrawableModule::GetRenderHash()
 
    static void SetNewManualHover(int direction);
    static bool WasLastHoverSetViaTab() { return sLastUIHoverWasSetViaTab; }
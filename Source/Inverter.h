@@ -53,6 +53,7 @@ public:
 private:
    //IDrawableModule
    void DrawModule() override;
+   bool CanCacheDrawing() const override { return true; }
    void GetModuleDimensions(float& w, float& h) override
    {
       w = 120;
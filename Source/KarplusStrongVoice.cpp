@@ -70,6 +70,8 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
    if (IsDone(time))
       return false;
 
+   UpdateModulationBlocks();
+
    int bufferSize = out->BufferSize();
    int channels = out->NumActiveChannels();
    double sampleIncrementMs = gInvSampleRateMs;
@@ -40,6 +40,7 @@ KompleteKontrol::KompleteKontrol()
 , mNeedKeysUpdate(false)
 , mController(nullptr)
 {
+   SetPollRate(kMaxPollRate);
    mKontrol.Init();
    mKontrol.QueueMessage("NIHWMainHandler", mKontrol.CreateMessage("NIGetServiceVersionMessage"));
    TheScale->AddListener(this);
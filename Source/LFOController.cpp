@@ -43,6 +43,7 @@ LFOController::LFOController()
 , mSlider(nullptr)
 , mStopBindTime(-1)
 {
+   SetPollRate(kMaxPollRate);
    assert(TheLFOController == nullptr);
    TheLFOController = this;
 }
@@ -59,6 +59,7 @@ LaunchpadKeyboard::LaunchpadKeyboard()
 , mPreserveChordRoot(true)
 , mPreserveChordRootCheckbox(nullptr)
 {
+   SetPollRate(kMaxPollRate);
    for (int i = 0; i < 128; ++i)
       mCurrentNotes[i] = 0;
 
@@ -40,6 +40,7 @@
 LinnstrumentControl::LinnstrumentControl()
 : mDevice(this)
 {
+   SetPollRate(kMaxPollRate);
    TheScale->AddListener(this);
 
    for (size_t i = 0; i < mGridColorState.size(); ++i)
@@ -11,12 +11,15 @@
 #ifndef LOCKFREEQUEUE_H_INCLUDED
 #define LOCKFREEQUEUE_H_INCLUDED
 
+#include <array>
+#include <atomic>
+
 /**
  * A simple single producer & consumer lock free queue, based on Herb Sutter's code:
  * http://www.drdobbs.com/parallel/writing-lock-free-code-a-corrected-queue/
  * 
  * This is a linked list, which can expand arbitrarily without losing old data,
- * but which has poor cache locality (I plan to write a ring buffer version soon).
+ * but which has poor cache locality. See LockFreeRingQueue below for a fixed size version.
  */
 template <typename T>
 class LockFreeQueue
@@ -90,5 +93,50 @@ private:
    Atomic<Node*> divider, last;
 };
 
+/**
+ * A single producer & consumer lock free queue in a preallocated ring buffer.
+ * Neither side ever allocates or blocks, but once the queue holds kCapacity items produce() fails
+ * and the item is dropped, so size it for the worst burst the consumer might have to catch up on.
+ */
+template <typename T, int kCapacity>
+class LockFreeRingQueue
+{
+   static_assert((kCapacity & (kCapacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+   /**
+     * Add an item to the queue. Returns false if the queue is full. Should only be called from producer's thread.
+     */
+   bool produce(const T& t)
+   {
+      unsigned int write = mWritePos.load(std::memory_order_relaxed);
+      if (write - mReadPos.load(std::memory_order_acquire) >= (unsigned int)kCapacity)
+         return false;
+
+      mItems[write & (kCapacity - 1)] = t;
+      mWritePos.store(write + 1, std::memory_order_release);
+      return true;
+   }
+
+   /**
+     * Consume an item in the queue. Returns false if no items left to consume. Should only be called from consumer's thread.
+     */
+   bool consume(T& result)
+   {
+      unsigned int read = mReadPos.load(std::memory_order_relaxed);
+      if (read == mWritePos.load(std::memory_order_acquire))
+         return false;
+
+      result = mItems[read & (kCapacity - 1)];
+      mReadPos.store(read + 1, std::memory_order_release);
+      return true;
+   }
+
+private:
+   std::array<T, kCapacity> mItems;
+   std::atomic<unsigned int> mWritePos{ 0 };
+   std::atomic<unsigned int> mReadPos{ 0 };
+};
+
 
 #endif // LOCKFREEQUEUE_H_INCLUDED
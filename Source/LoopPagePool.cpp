@@ -0,0 +1,184 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    LoopPagePool.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "LoopPagePool.h"
+#include "SynthGlobals.h"
+
+//static
+LoopPagePool* LoopPagePool::Get()
+{
+   static LoopPagePool sPool;
+   return &sPool;
+}
+
+LoopPagePool::LoopPagePool()
+: mRuns(new Run[kMaxRuns])
+{
+   //loop storage classes double in size from 8 pages (~1.4s at 48k) up to a full MAX_BUFFER_SIZE loop
+   int maxLoopPages = NumPagesFor(MAX_BUFFER_SIZE);
+   mSizeClassPages.push_back(1);
+   for (int pages = 8; (int)mSizeClassPages.size() < kMaxSizeClasses; pages *= 2)
+   {
+      mSizeClassPages.push_back(MIN(pages, maxLoopPages));
+      if (pages >= maxLoopPages)
+         break;
+   }
+}
+
+LoopPagePool::~LoopPagePool()
+{
+   for (int i = 0; i < mNumRuns; ++i)
+      delete[] mRuns[i].mData;
+}
+
+void LoopPagePool::Push(FreeList& list, int run)
+{
+   uint64_t head = list.mHead.load(std::memory_order_relaxed);
+   uint64_t newHead;
+   do
+   {
+      mRuns[run].mNext.store(int(head & 0xffffffff), std::memory_order_relaxed);
+      newHead = uint64_t(run + 1) | (((head >> 32) + 1) << 32);
+   } while (!list.mHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+   ++list.mCount;
+}
+
+int LoopPagePool::Pop(FreeList& list)
+{
+   uint64_t head = list.mHead.load(std::memory_order_acquire);
+   while ((head & 0xffffffff) != 0)
+   {
+      int run = int(head & 0xffffffff) - 1;
+      uint64_t newHead = uint64_t(mRuns[run].mNext.load(std::memory_order_relaxed)) | (((head >> 32) + 1) << 32);
+      if (list.mHead.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+      {
+         --list.mCount;
+         return run;
+      }
+   }
+   return -1;
+}
+
+int LoopPagePool::AcquirePage()
+{
+   return Pop(mFreeRuns[0]);
+}
+
+int LoopPagePool::SizeClassFor(int minPages) const
+{
+   for (int sizeClass = 1; sizeClass < (int)mSizeClassPages.size(); ++sizeClass)
+   {
+      if (mSizeClassPages[sizeClass] >= minPages)
+         return sizeClass;
+   }
+   return -1;
+}
+
+int LoopPagePool::AcquireRun(int minSamples)
+{
+   int firstClass = SizeClassFor(NumPagesFor(minSamples));
+   if (firstClass == -1)
+      return -1;
+   for (int sizeClass = firstClass; sizeClass < (int)mSizeClassPages.size(); ++sizeClass)
+   {
+      int run = Pop(mFreeRuns[sizeClass]);
+      if (run != -1)
+         return run;
+   }
+   return -1;
+}
+
+void LoopPagePool::Release(int run)
+{
+   Push(mFreeRuns[mRuns[run].mSizeClass], run);
+}
+
+void LoopPagePool::Retire(int run)
+{
+   Push(mRetiredRuns, run);
+}
+
+void LoopPagePool::AddRun(int sizeClass)
+{
+   if (mNumRuns == kMaxRuns)
+      return;
+
+   Run& run = mRuns[mNumRuns];
+   run.mNumPages = mSizeClassPages[sizeClass];
+   run.mSizeClass = sizeClass;
+   run.mData = new float[run.mNumPages * kPageSize];
+   ++mNumRunsInClass[sizeClass];
+   Push(mFreeRuns[sizeClass], mNumRuns++); //publishes the run to the other threads
+}
+
+void LoopPagePool::UpdateReservation(const void* owner, int numPages, int numRuns /*= 0*/, int runSamples /*= 0*/)
+{
+   Reservation& reservation = mReservations[owner];
+   reservation.mNumPages = numPages;
+   reservation.mNumRuns = numRuns;
+   reservation.mRunSamples = runSamples;
+   TopUp();
+}
+
+void LoopPagePool::RemoveReservation(const void* owner)
+{
+   mReservations.erase(owner);
+}
+
+void LoopPagePool::Poll()
+{
+   //anything retired before the last frame has had a whole frame for its old owner to let go of it
+   for (int run = Pop(mCoolingRuns); run != -1; run = Pop(mCoolingRuns))
+      Release(run);
+   for (int run = Pop(mRetiredRuns); run != -1; run = Pop(mRetiredRuns))
+      Push(mCoolingRuns, run);
+
+   TopUp();
+}
+
+void LoopPagePool::TopUp()
+{
+   //reservations add up across owners, since each one could use its whole reservation at once
+   int totalPages = 0;
+   int spareRuns[kMaxSizeClasses]{};
+   for (const auto& reservation : mReservations)
+   {
+      totalPages += reservation.second.mNumPages;
+      int sizeClass = SizeClassFor(NumPagesFor(reservation.second.mRunSamples));
+      if (sizeClass != -1)
+         spareRuns[sizeClass] += reservation.second.mNumRuns;
+   }
+
+   while (mNumRunsInClass[0] < totalPages && mNumRuns < kMaxRuns)
+      AddRun(0);
+
+   for (int sizeClass = 1; sizeClass < (int)mSizeClassPages.size(); ++sizeClass)
+   {
+      while (mFreeRuns[sizeClass].mCount < spareRuns[sizeClass] && mNumRuns < kMaxRuns)
+         AddRun(sizeClass);
+   }
+}
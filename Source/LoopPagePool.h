@@ -0,0 +1,106 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    LoopPagePool.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+//shared arena of sample memory for loopers, handed out in runs of whole pages. a run is rounded up to one of a
+//few size classes: loop storage takes one run per channel (see ChannelBuffer::UseLoopPagePool()), and undo
+//snapshots take single pages. memory is only ever allocated on the main thread (UpdateReservation() and Poll()),
+//and runs go in and out through lock-free free lists, so acquiring and releasing them is safe from any thread and never allocates
+class LoopPagePool
+{
+public:
+   static LoopPagePool* Get();
+
+   static const int kPageSize = 8192;
+   static int NumPagesFor(int numSamples) { return (numSamples + kPageSize - 1) / kPageSize; }
+
+   int AcquirePage(); //a single page, returns -1 if none are free
+   int AcquireRun(int minSamples); //the smallest free run that holds minSamples, returns -1 if none are free
+   void Release(int run);
+   void Retire(int run); //like Release(), for memory another thread might still be touching. it isn't handed out again until a full frame has passed
+   float* GetData(int run) const { return mRuns[run].mData; }
+   int GetSize(int run) const { return mRuns[run].mNumPages * kPageSize; }
+
+   //main thread. the arena keeps enough single pages for every owner's reservation combined, plus numRuns free
+   //runs of at least runSamples for each owner, so that its loop can grow that far on the audio thread
+   void UpdateReservation(const void* owner, int numPages, int numRuns = 0, int runSamples = 0);
+   void RemoveReservation(const void* owner);
+
+   void Poll(); //main thread, once per frame: hands retired runs back out, and tops up the arena
+
+private:
+   LoopPagePool();
+   ~LoopPagePool();
+
+   struct Run
+   {
+      float* mData{ nullptr };
+      int mNumPages{ 0 };
+      int mSizeClass{ 0 };
+      std::atomic<int> mNext{ 0 }; //index + 1 of the next run in its free list, 0 at the end
+   };
+
+   //a stack of run indices. the head packs index + 1 with a counter that changes on every push and pop, so a pop
+   //that races with another pop and push of the same run fails its compare-exchange rather than corrupting the list
+   struct FreeList
+   {
+      std::atomic<uint64_t> mHead{ 0 };
+      std::atomic<int> mCount{ 0 };
+   };
+
+   void Push(FreeList& list, int run);
+   int Pop(FreeList& list);
+   void AddRun(int sizeClass);
+   int SizeClassFor(int minPages) const;
+   void TopUp();
+
+   struct Reservation
+   {
+      int mNumPages{ 0 };
+      int mNumRuns{ 0 };
+      int mRunSamples{ 0 };
+   };
+
+   static const int kMaxRuns = 1 << 16;
+   static const int kMaxSizeClasses = 16;
+
+   std::unique_ptr<Run[]> mRuns;
+   int mNumRuns{ 0 };
+   std::vector<int> mSizeClassPages; //class 0 is single pages, the rest are for loop storage, up to MAX_BUFFER_SIZE
+   FreeList mFreeRuns[kMaxSizeClasses];
+   int mNumRunsInClass[kMaxSizeClasses]{};
+   FreeList mRetiredRuns;
+   FreeList mCoolingRuns; //retired before the last Poll()
+   std::map<const void*, Reservation> mReservations;
+};
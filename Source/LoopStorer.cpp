@@ -46,6 +46,7 @@ LoopStorer::LoopStorer()
 , mClearButton(nullptr)
 , mLooperCable(nullptr)
 {
+   SetPollRate(kMaxPollRate);
 }
 
 void LoopStorer::Init()
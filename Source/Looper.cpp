@@ -35,6 +35,9 @@
 #include "Rewriter.h"
 #include "FillSaveDropdown.h"
 #include "LooperGranulator.h"
+#include "LoopPagePool.h"
+
+#include <algorithm>
 
 float Looper::mBeatwheelPosRight = 0;
 float Looper::mBeatwheelDepthRight = 0;
@@ -72,6 +75,9 @@ Looper::Looper()
 , mHalveSpeedButton(nullptr)
 , mUndoButton(nullptr)
 , mWantUndo(false)
+, mWantClear(false)
+, mNumUndoPages(0)
+, mHasUndo(false)
 , mLoopPosOffset(0)
 , mLoopPosOffsetSlider(nullptr)
 , mWriteOffsetButton(nullptr)
@@ -116,10 +122,20 @@ Looper::Looper()
 , mGranulator(nullptr)
 , mBufferTempo(-1)
 {
-   //TODO(Ryan) buffer sizes
-   mBuffer = new ChannelBuffer(MAX_BUFFER_SIZE);
-   mUndoBuffer = new ChannelBuffer(MAX_BUFFER_SIZE);
-   Clear();
+   SetPollRate(kMaxPollRate);
+   //the loop grows into runs from the pool as SetLoopLength() asks for more
+   int initialLoopLength = 4 * 60.0f / TheTransport->GetTempo() * gSampleRate;
+   UpdatePoolReservation(initialLoopLength);
+   mBuffer = new ChannelBuffer(0);
+   mBuffer->UseLoopPagePool();
+   mBuffer->EnableWaveformPyramid();
+   for (int ch = 0; ch < ChannelBuffer::kMaxNumChannels; ++ch)
+   {
+      mUndoPages[ch] = std::vector<std::atomic<int>>(LoopPagePool::NumPagesFor(MAX_BUFFER_SIZE));
+      for (auto& undoPage : mUndoPages[ch])
+         undoPage = -1;
+   }
+   DoClear();
 
    mMuteRamp.SetValue(1);
 
@@ -129,7 +145,7 @@ Looper::Looper()
       mLastInputSample[i] = 0;
    }
 
-   SetLoopLength(4 * 60.0f / TheTransport->GetTempo() * gSampleRate);
+   SetLoopLength(initialLoopLength);
 }
 
 void Looper::CreateUIControls()
@@ -204,8 +220,9 @@ void Looper::CreateUIControls()
 
 Looper::~Looper()
 {
+   ReleaseUndoPages();
+   LoopPagePool::Get()->RemoveReservation(this);
    delete mBuffer;
-   delete mUndoBuffer;
    for (int i = 0; i < ChannelBuffer::kMaxNumChannels; ++i)
       delete mPitchShifter[i];
 }
@@ -240,6 +257,7 @@ ChannelBuffer* Looper::GetLoopBuffer(int& loopLength)
 
 void Looper::SetLoopBuffer(ChannelBuffer* buffer)
 {
+   buffer->EnableWaveformPyramid();
    mQueuedNewBuffer = buffer;
 }
 
@@ -261,6 +279,22 @@ void Looper::Poll()
 
    if (mGranulator && mGranulator->IsDeleted())
       mGranulator = nullptr;
+
+   int failedGrowLength = mFailedGrowLength.exchange(0);
+   if (failedGrowLength > 0)
+      ofLog() << "looper buffer couldn't grow to " << failedGrowLength << " samples, clamped loop length";
+   UpdatePoolReservation(MAX(mLoopLength, failedGrowLength));
+}
+
+//keep enough pages on hand for a full undo snapshot, and spare runs for the loop to double in length or to take a full
+//commit from the recorder, so that neither ever has to allocate on the audio thread
+void Looper::UpdatePoolReservation(int loopLength)
+{
+   int growLength = loopLength * 2;
+   if (mRecorder)
+      growLength = MAX(growLength, abs(int(TheTransport->MsPerBar() / 1000 * gSampleRate)) * mRecorder->NumBars());
+   growLength = MIN(growLength, MAX_BUFFER_SIZE);
+   LoopPagePool::Get()->UpdateReservation(this, LoopPagePool::NumPagesFor(loopLength) * ChannelBuffer::kMaxNumChannels, ChannelBuffer::kMaxNumChannels, growLength);
 }
 
 void Looper::Process(double time)
@@ -280,10 +314,15 @@ void Looper::Process(double time)
    SyncBuffers();
    mBuffer->SetNumActiveChannels(GetBuffer()->NumActiveChannels());
    mWorkBuffer.SetNumActiveChannels(GetBuffer()->NumActiveChannels());
-   mUndoBuffer->SetNumActiveChannels(GetBuffer()->NumActiveChannels());
 
    bool doGranular = mGranulator != nullptr && mGranulator->IsActive();
 
+   if (mWantClear)
+   {
+      BeginUndoSnapshot();
+      DoClear();
+      mWantClear = false;
+   }
    if (mWantBakeVolume)
       BakeVolume();
    if (mWantShiftDownbeat)
@@ -337,6 +376,7 @@ void Looper::Process(double time)
       mBuffer = mQueuedNewBuffer;
       mBufferMutex.unlock();
       mQueuedNewBuffer = nullptr;
+      ReleaseUndoPages();
    }
 
    if (mKeepPitch)
@@ -345,6 +385,8 @@ void Looper::Process(double time)
    if (mPitchShift != 1)
       latencyOffset = mPitchShifter[0]->GetLatency();
 
+   int firstWritePos = mLoopLength;
+   int lastWritePos = -1;
    double processStartTime = gTime;
    for (int i = 0; i < bufferSize; ++i)
    {
@@ -388,7 +430,15 @@ void Looper::Process(double time)
          //write one sample the past so we don't end up feeding into the next output
          float writeAmount = mWriteInputRamp.Value(time);
          if (writeAmount > 0)
+         {
+            PreserveForUndoAt(offset - 1);
             WriteInterpolatedSample(offset - 1, mBuffer->GetChannel(ch), mLoopLength, mLastInputSample[ch] * writeAmount);
+
+            double writePos = offset - 1;
+            FloatWrap(writePos, mLoopLength);
+            firstWritePos = MIN(firstWritePos, int(writePos));
+            lastWritePos = MAX(lastWritePos, int(writePos));
+         }
          mLastInputSample[ch] = GetBuffer()->GetChannel(ch)[i];
 
          output[ch] = mSwitchAndRamp.Process(ch, output[ch] * volSq);
@@ -401,6 +451,14 @@ void Looper::Process(double time)
       time += gInvSampleRateMs;
    }
 
+   if (lastWritePos >= 0)
+   {
+      if (lastWritePos - firstWritePos < mLoopLength / 2)
+         mBuffer->WaveformChanged(firstWritePos, lastWritePos - firstWritePos + 2); //interpolated writes touch the following sample too
+      else //wrapped around the loop point
+         mBuffer->WaveformChanged(0, mLoopLength);
+   }
+
    if (mPitchShift != 1)
    {
       for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
@@ -444,15 +502,16 @@ void Looper::DoCommit()
 
    {
       PROFILER(Looper_DoCommit_undo);
-      mUndoBuffer->CopyFrom(mBuffer, mLoopLength);
+      BeginUndoSnapshot();
+      PreserveForUndo(0, mLoopLength);
    }
 
    if (mReplaceOnCommit)
-      Clear();
+      DoClear();
 
    if (mMute)
    {
-      Clear();
+      DoClear();
       mMute = false;
       mMuteRamp.Start(gTime, mMute ? 0 : 1, gTime + 1);
    }
@@ -478,6 +537,7 @@ void Looper::DoCommit()
             mBuffer->GetChannel(ch)[pos] += mCommitBuffer->GetSample(ofClamp(commitLength - i + commitSamplesBack, 0, MAX_BUFFER_SIZE - 1), ch) * fade;
          }
       }
+      mBuffer->WaveformChanged(0, mLoopLength);
    }
 
    mClearCommitBuffer = true;
@@ -485,17 +545,111 @@ void Looper::DoCommit()
 
 void Looper::Fill(ChannelBuffer* buffer, int length)
 {
+   if (!GrowLoopBuffer(length))
+      length = mBuffer->BufferSize();
+   PreserveForUndo(0, length);
    mBuffer->CopyFrom(buffer, length);
 }
 
 void Looper::DoUndo()
 {
-   ChannelBuffer* swap = mUndoBuffer;
-   mUndoBuffer = mBuffer;
-   mBuffer = swap;
+   //swap the preserved pages with the live ones, so that undoing again redoes
+   if (mHasUndo)
+   {
+      int bufferSize = mBuffer->BufferSize();
+      for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
+      {
+         for (int page = 0; page < (int)mUndoPages[ch].size(); ++page)
+         {
+            int undoPage = mUndoPages[ch][page];
+            if (undoPage != -1)
+            {
+               int start = page * LoopPagePool::kPageSize;
+               int length = MIN(LoopPagePool::kPageSize, bufferSize - start);
+               float* undoData = LoopPagePool::Get()->GetData(undoPage);
+               std::swap_ranges(undoData, undoData + length, mBuffer->GetChannel(ch) + start);
+            }
+         }
+      }
+      mBuffer->WaveformChanged();
+   }
    mWantUndo = false;
 }
 
+void Looper::BeginUndoSnapshot()
+{
+   ReleaseUndoPages();
+   mHasUndo = true;
+}
+
+//call before modifying [start, start+length) of mBuffer, so the undo snapshot can be restored later.
+//the audio thread and the UI can both get here, so a page only goes into the snapshot if nobody beat us to it
+void Looper::PreserveForUndo(int start, int length)
+{
+   if (!mHasUndo || length <= 0)
+      return;
+
+   int bufferSize = mBuffer->BufferSize();
+   int firstPage = MAX(start, 0) / LoopPagePool::kPageSize;
+   int lastPage = MIN(start + length, bufferSize) - 1;
+   lastPage = MIN(lastPage / LoopPagePool::kPageSize, (int)mUndoPages[0].size() - 1);
+   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
+   {
+      for (int page = firstPage; page <= lastPage; ++page)
+      {
+         if (mUndoPages[ch][page] != -1)
+            continue;
+
+         int undoPage = LoopPagePool::Get()->AcquirePage();
+         if (undoPage == -1) //out of pages, we can't restore this snapshot
+         {
+            ReleaseUndoPages();
+            return;
+         }
+
+         int pageStart = page * LoopPagePool::kPageSize;
+         BufferCopy(LoopPagePool::Get()->GetData(undoPage), mBuffer->GetChannel(ch) + pageStart, MIN(LoopPagePool::kPageSize, bufferSize - pageStart));
+         int empty = -1;
+         if (mUndoPages[ch][page].compare_exchange_strong(empty, undoPage))
+            ++mNumUndoPages;
+         else
+            LoopPagePool::Get()->Release(undoPage);
+      }
+   }
+}
+
+void Looper::PreserveForUndoAt(double loopPos)
+{
+   if (!mHasUndo)
+      return;
+
+   FloatWrap(loopPos, mLoopLength);
+   int pos = int(loopPos);
+   PreserveForUndo(pos, 1);
+   PreserveForUndo(int(loopPos + 1) % mLoopLength, 1);
+}
+
+void Looper::ReleaseUndoPages()
+{
+   if (mNumUndoPages > 0)
+   {
+      for (int ch = 0; ch < ChannelBuffer::kMaxNumChannels; ++ch)
+      {
+         for (auto& undoPage : mUndoPages[ch])
+         {
+            int page = undoPage.exchange(-1);
+            if (page != -1)
+            {
+               //retired rather than released, in case another thread is still reading from it
+               LoopPagePool::Get()->Retire(page);
+               --mNumUndoPages;
+            }
+         }
+      }
+   }
+   mHasUndo = false;
+}
+
 int Looper::GetRecorderNumBars() const
 {
    if (mRecorder)
@@ -641,6 +795,7 @@ void Looper::ResampleForSpeed(float speed)
    mLoopPos /= speed;
    while (mLoopPos < 0)
       mLoopPos += mLoopLength;
+   PreserveForUndo(0, mLoopLength);
    for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
    {
       float* oldBuffer = new float[oldLoopLength];
@@ -652,6 +807,7 @@ void Looper::ResampleForSpeed(float speed)
       }
       delete[] oldBuffer;
    }
+   mBuffer->WaveformChanged(0, mLoopLength);
 
    if (mKeepPitch)
    {
@@ -884,8 +1040,9 @@ void Looper::DrawBeatwheel()
    ofPopMatrix();
 }
 
-void Looper::Clear()
+void Looper::DoClear()
 {
+   PreserveForUndo(0, mLoopLength);
    mBuffer->Clear();
    mLastCommitTime = gTime;
    mVol = 1;
@@ -902,9 +1059,11 @@ void Looper::SetNumBars(int numBars)
 
 void Looper::BakeVolume()
 {
-   mUndoBuffer->CopyFrom(mBuffer, mLoopLength);
+   BeginUndoSnapshot();
+   PreserveForUndo(0, mLoopLength);
    for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
       Mult(mBuffer->GetChannel(ch), mVol * mVol, mLoopLength);
+   mBuffer->WaveformChanged(0, mLoopLength);
    mVol = 1;
    mSmoothedVol = 1;
    mWantBakeVolume = false;
@@ -922,17 +1081,41 @@ void Looper::UpdateNumBars(int oldNumBars)
    {
       int oldLoopLength = abs(int(TheTransport->MsPerBar() * oldNumBars / 1000 * gSampleRate));
       oldLoopLength = MIN(oldLoopLength, MAX_BUFFER_SIZE - 1);
-      for (int i = 1; i < mNumBars / oldNumBars; ++i)
+      for (int i = 1; i < mNumBars / oldNumBars && oldLoopLength * (i + 1) <= mBuffer->BufferSize(); ++i)
       {
+         PreserveForUndo(oldLoopLength * i, oldLoopLength);
          for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
             BufferCopy(mBuffer->GetChannel(ch) + oldLoopLength * i, mBuffer->GetChannel(ch), oldLoopLength);
+         mBuffer->WaveformChanged(oldLoopLength * i, oldLoopLength);
       }
    }
 }
 
+bool Looper::GrowLoopBuffer(int length)
+{
+   if (length <= mBuffer->BufferSize())
+      return true;
+
+   //off the audio thread, hold it off while the channels are copied into their new runs, so nothing it writes to the old ones is lost
+   bool holdAudioThread = juce::MessageManager::existsAndIsCurrentThread();
+   if (holdAudioThread)
+      TheSynth->GetAudioMutex()->Lock("Looper::GrowLoopBuffer()");
+   mBufferMutex.lock();
+   bool grown = mBuffer->SetMinimumSize(length);
+   mBufferMutex.unlock();
+   if (holdAudioThread)
+      TheSynth->GetAudioMutex()->Unlock();
+   return grown;
+}
+
 void Looper::SetLoopLength(int length)
 {
    assert(length > 0);
+   if (!GrowLoopBuffer(length))
+   {
+      mFailedGrowLength = length; //reported from Poll(), since this can be on the audio thread
+      length = mBuffer->BufferSize();
+   }
    mLoopLength = length;
    if (mLoopPosOffsetSlider != nullptr)
       mLoopPosOffsetSlider->SetExtents(0, length);
@@ -947,6 +1130,9 @@ void Looper::MergeIn(Looper* otherLooper)
 
    otherLooper->SetNumBars(newNumBars);
 
+   PreserveForUndo(0, mLoopLength);
+   otherLooper->PreserveForUndo(0, mLoopLength);
+
    if (mVol > 0.01f)
    {
       for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
@@ -954,6 +1140,7 @@ void Looper::MergeIn(Looper* otherLooper)
          Mult(otherLooper->mBuffer->GetChannel(ch), (otherLooper->mVol * otherLooper->mVol) / (mVol * mVol), mLoopLength); //keep other looper at same apparent volume
          Add(mBuffer->GetChannel(ch), otherLooper->mBuffer->GetChannel(ch), mLoopLength);
       }
+      mBuffer->WaveformChanged(0, mLoopLength);
    }
    else //ours was silent, just replace it
    {
@@ -961,7 +1148,7 @@ void Looper::MergeIn(Looper* otherLooper)
       mVol = 1;
    }
 
-   otherLooper->Clear();
+   otherLooper->DoClear();
 
    if (mRecorder)
       mLastCommit = mRecorder->IncreaseCommitCount();
@@ -982,13 +1169,16 @@ void Looper::SwapBuffers(Looper* otherLooper)
    SetLoopLength(length);
    mNumBars = numBars;
    mVol = vol;
+   ReleaseUndoPages();
+   otherLooper->ReleaseUndoPages();
 }
 
 void Looper::CopyBuffer(Looper* sourceLooper)
 {
    assert(sourceLooper);
-   mBuffer->CopyFrom(sourceLooper->mBuffer, mLoopLength);
    SetLoopLength(sourceLooper->mLoopLength);
+   PreserveForUndo(0, mLoopLength);
+   mBuffer->CopyFrom(sourceLooper->mBuffer, mLoopLength);
    mNumBars = sourceLooper->mNumBars;
 }
 
@@ -1044,6 +1234,7 @@ void Looper::SampleDropped(int x, int y, Sample* sample)
       SetNumBars(sample->GetNumBars());
 
    float lengthRatio = float(numSamples) / mLoopLength;
+   PreserveForUndo(0, mLoopLength);
    mBuffer->SetNumActiveChannels(sample->NumChannels());
    for (int i = 0; i < mLoopLength; ++i)
    {
@@ -1051,6 +1242,7 @@ void Looper::SampleDropped(int x, int y, Sample* sample)
       for (int ch = 0; ch < sample->NumChannels(); ++ch)
          mBuffer->GetChannel(ch)[i] = GetInterpolatedSample(offset, sample->Data()->GetChannel(ch), numSamples);
    }
+   mBuffer->WaveformChanged(0, mLoopLength);
 }
 
 void Looper::GetModuleDimensions(float& width, float& height)
@@ -1079,10 +1271,7 @@ void Looper::OnClicked(int x, int y, bool right)
 void Looper::ButtonClicked(ClickButton* button)
 {
    if (button == mClearButton)
-   {
-      mUndoBuffer->CopyFrom(mBuffer, mLoopLength);
-      Clear();
-   }
+      mWantClear = true;
    if (button == mMergeButton && mRecorder)
       mRecorder->RequestMerge(this);
    if (button == mSwapButton && mRecorder)
@@ -1210,45 +1399,20 @@ void Looper::HalveNumBars()
 void Looper::DoShiftMeasure()
 {
    int measureSize = int(TheTransport->MsPerBar() * gSampleRate / 1000);
-   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-   {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
-      BufferCopy(newBuffer, mBuffer->GetChannel(ch) + measureSize, mLoopLength - measureSize);
-      BufferCopy(newBuffer + mLoopLength - measureSize, mBuffer->GetChannel(ch), measureSize);
-      mBufferMutex.lock();
-      mBuffer->SetChannelPointer(newBuffer, ch, true);
-      mBufferMutex.unlock();
-   }
+   RotateLoop(measureSize);
    mWantShiftMeasure = false;
 }
 
 void Looper::DoHalfShift()
 {
    int halfMeasureSize = int(TheTransport->MsPerBar() * gSampleRate / 1000 / 2);
-   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-   {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
-      BufferCopy(newBuffer, mBuffer->GetChannel(ch) + halfMeasureSize, mLoopLength - halfMeasureSize);
-      BufferCopy(newBuffer + mLoopLength - halfMeasureSize, mBuffer->GetChannel(ch), halfMeasureSize);
-      mBufferMutex.lock();
-      mBuffer->SetChannelPointer(newBuffer, ch, true);
-      mBufferMutex.unlock();
-   }
+   RotateLoop(halfMeasureSize);
    mWantHalfShift = false;
 }
 
 void Looper::DoShiftDownbeat()
 {
-   int shift = int(mLoopPos);
-   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-   {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
-      BufferCopy(newBuffer, mBuffer->GetChannel(ch) + shift, mLoopLength - shift);
-      BufferCopy(newBuffer + mLoopLength - shift, mBuffer->GetChannel(ch), shift);
-      mBufferMutex.lock();
-      mBuffer->SetChannelPointer(newBuffer, ch, true);
-      mBufferMutex.unlock();
-   }
+   RotateLoop(int(mLoopPos));
    mWantShiftDownbeat = false;
 }
 
@@ -1256,21 +1420,31 @@ void Looper::DoShiftOffset()
 {
    int shift = int(mLoopPosOffset);
    if (shift != 0)
-   {
-      for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-      {
-         float* newBuffer = new float[MAX_BUFFER_SIZE];
-         BufferCopy(newBuffer, mBuffer->GetChannel(ch) + shift, mLoopLength - shift);
-         BufferCopy(newBuffer + mLoopLength - shift, mBuffer->GetChannel(ch), shift);
-         mBufferMutex.lock();
-         mBuffer->SetChannelPointer(newBuffer, ch, true);
-         mBufferMutex.unlock();
-      }
-   }
+      RotateLoop(shift);
    mWantShiftOffset = false;
    mLoopPosOffset = 0;
 }
 
+//rotate in place, so that shifting on the audio thread doesn't need a new buffer
+void Looper::RotateLoop(int shift)
+{
+   shift %= mLoopLength;
+   if (shift < 0)
+      shift += mLoopLength;
+   if (shift == 0)
+      return;
+
+   PreserveForUndo(0, mLoopLength);
+   mBufferMutex.lock();
+   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
+   {
+      float* channel = mBuffer->GetChannel(ch);
+      std::rotate(channel, channel + shift, channel + mLoopLength);
+   }
+   mBufferMutex.unlock();
+   mBuffer->WaveformChanged(0, mLoopLength);
+}
+
 void Looper::Rewrite()
 {
    mWantRewrite = true;
@@ -1350,6 +1524,9 @@ void Looper::LoadState(FileStreamIn& in)
    if (rev >= 1)
       in >> mBufferTempo;
    int readLength;
+   ReleaseUndoPages();
+   UpdatePoolReservation(mLoopLength);
+   GrowLoopBuffer(mLoopLength);
    mBuffer->Load(in, readLength, ChannelBuffer::LoadMode::kAnyBufferSize);
    assert(mLoopLength == readLength);
 }
@@ -26,6 +26,7 @@
 #ifndef __modularSynth__Looper__
 #define __modularSynth__Looper__
 
+#include <atomic>
 #include <iostream>
 #include "IAudioProcessor.h"
 #include "IDrawableModule.h"
@@ -59,7 +60,7 @@ public:
    void CreateUIControls() override;
 
    void SetRecorder(LooperRecorder* recorder);
-   void Clear();
+   void Clear() { mWantClear = true; }
    void Commit(RollingBuffer* commitBuffer = nullptr);
    void Fill(ChannelBuffer* buffer, int length);
    void ResampleForSpeed(float speed);
@@ -127,10 +128,18 @@ private:
    void DoHalfShift();
    void DoShiftDownbeat();
    void DoShiftOffset();
+   void RotateLoop(int shift);
    void DoCommit();
    void UpdateNumBars(int oldNumBars);
    void BakeVolume();
    void DoUndo();
+   void DoClear();
+   bool GrowLoopBuffer(int length);
+   void UpdatePoolReservation(int loopLength);
+   void BeginUndoSnapshot();
+   void PreserveForUndo(int start, int length);
+   void PreserveForUndoAt(double loopPos);
+   void ReleaseUndoPages();
    void ProcessFourTet(double time, int sampleIdx);
    void ProcessScratch();
    void ProcessBeatwheel(double time, int sampleIdx);
@@ -157,6 +166,7 @@ private:
    RollingBuffer* mRecordBuffer;
    int mNumBars;
    ClickButton* mClearButton;
+   bool mWantClear;
    DropdownList* mNumBarsSelector;
    float mVol;
    float mSmoothedVol;
@@ -180,7 +190,10 @@ private:
    ClickButton* mCommitButton;
    ClickButton* mDoubleSpeedButton;
    ClickButton* mHalveSpeedButton;
-   ChannelBuffer* mUndoBuffer;
+   std::vector<std::atomic<int>> mUndoPages[ChannelBuffer::kMaxNumChannels]; //copy-on-write pages from LoopPagePool, -1 where unchanged since the snapshot
+   std::atomic<int> mNumUndoPages;
+   std::atomic<bool> mHasUndo;
+   std::atomic<int> mFailedGrowLength{ 0 }; //set when the pool couldn't grow the loop, so Poll() can report it and reserve more
    ClickButton* mUndoButton;
    bool mWantUndo;
    bool mReplaceOnCommit;
@@ -41,6 +41,7 @@ LooperRecorder::LooperRecorder()
 , mRecordBuffer(MAX_BUFFER_SIZE)
 , mWriteBuffer(gBufferSize)
 {
+   SetPollRate(kMaxPollRate);
    mQuietInputRamp.SetValue(1);
 }
 
@@ -16,6 +16,7 @@ using namespace juce;
 #include "SynthGlobals.h"
 #include "Push2Control.h" //TODO(Ryan) remove
 #include "SpaceMouseControl.h"
+#include "ModuleRenderCache.h"
 #include "UserPrefs.h"
 
 #ifdef JUCE_WINDOWS
@@ -126,13 +127,20 @@ public:
 
       mSynth.Poll();
 
+      //render at the full timer rate, unless the user opted to drop down to the idle rate while they're not doing anything.
+      //off by default, since meters, scopes and playheads keep moving during hands-off playback
+      int64 time = Time::currentTimeMillis();
+      const int64 kInteractionTimeoutMs = 1500;
+      bool interacting = time - mLastInteractionTime < kInteractionTimeoutMs || mSynth.IsMouseButtonHeld(1) || mSynth.IsMouseButtonHeld(2) || mSynth.IsMouseButtonHeld(3);
+      int frameRate = (interacting || !UserPrefs.lower_frame_rate_when_idle.Get()) ? kMaxFrameRate : UserPrefs.idle_frame_rate.Get();
 #if DEBUG
-      if (sRenderFrame % 2 == 0)
-#else
-      if (true)
+      frameRate = MIN(frameRate, kMaxFrameRate / 2);
 #endif
+      const int64 kTimerSlackMs = 4; //so we don't skip a frame because a timer tick came in a little early
+      if (sRenderFrame == 0 || time - mLastRenderRequestTime >= 1000 / frameRate - kTimerSlackMs)
       {
          openGLContext.triggerRepaint();
+         mLastRenderRequestTime = time;
       }
       ++sRenderFrame;
 
@@ -321,7 +329,7 @@ public:
          }
       }
 
-      startTimerHz(60);
+      startTimerHz(kMaxFrameRate);
    }
 
    void shutdown() override
@@ -351,6 +359,8 @@ public:
 
       static float kMotionTrails = .4f;
 
+      ModuleRenderCache::BeginFrame(mVG, mPixelRatio);
+
       ofVec3f bgColor(ModularSynth::sBackgroundR, ModularSynth::sBackgroundG, ModularSynth::sBackgroundB);
       glViewport(0, 0, width * mPixelRatio, height * mPixelRatio);
       glClearColor(bgColor.x, bgColor.y, bgColor.z, 0);
@@ -415,29 +425,39 @@ private:
       return 1;
    }
 
+   void NoteInteraction()
+   {
+      mLastInteractionTime = Time::currentTimeMillis();
+   }
+
    void mouseDown(const MouseEvent& e) override
    {
+      NoteInteraction();
       mSynth.MousePressed(e.getMouseDownX(), e.getMouseDownY(), GetMouseButton(e), e.source);
    }
 
    void mouseUp(const MouseEvent& e) override
    {
+      NoteInteraction();
       mSynth.MouseReleased(e.getPosition().x, e.getPosition().y, GetMouseButton(e), e.source);
    }
 
    void mouseDrag(const MouseEvent& e) override
    {
+      NoteInteraction();
       mSynth.MouseDragged(e.getPosition().x, e.getPosition().y, GetMouseButton(e), e.source);
    }
 
    void mouseMove(const MouseEvent& e) override
    {
+      NoteInteraction();
       //Don't do mouse move in here, it really slows UI responsiveness in some scenarios. We do it when we render instead.
       //mSynth.MouseMoved(e.getPosition().x, e.getPosition().y);
    }
 
    void mouseWheelMove(const MouseEvent& e, const MouseWheelDetails& wheel) override
    {
+      NoteInteraction();
       float invert = 1;
       if (wheel.isReversed)
          invert = -1;
@@ -452,6 +472,7 @@ private:
 
    void mouseMagnify(const MouseEvent& e, float scaleFactor) override
    {
+      NoteInteraction();
       mSynth.MouseMagnify(e.getPosition().x, e.getPosition().y, scaleFactor, e.source);
    }
 
@@ -482,6 +503,8 @@ private:
       }
 #endif
 
+      NoteInteraction();
+
       int keyCode = key.getTextCharacter();
       if (keyCode < 32 || key.getModifiers().isAltDown())
          keyCode = key.getKeyCode();
@@ -525,6 +548,7 @@ private:
 
    void filesDropped(const StringArray& files, int x, int y) override
    {
+      NoteInteraction();
       std::vector<std::string> strFiles;
       for (auto file : files)
          strFiles.push_back(file.toStdString());
@@ -571,6 +595,9 @@ private:
    NVGcontext* mVG;
    NVGcontext* mFontBoundsVG;
    int64 mLastFpsUpdateTime;
+   int64 mLastInteractionTime{ 0 };
+   int64 mLastRenderRequestTime{ 0 };
+   static constexpr int kMaxFrameRate = 60;
    int mFrameCountAccum;
    std::list<int> mPressedKeys;
    double mPixelRatio;
@@ -29,6 +29,9 @@
 
 #include "OpenFrameworksPort.h"
 
+#include <cstdint>
+#include <cstring>
+
 #define CUBE(x) ((x) * (x) * (x))
 #define SQUARE(x) ((x) * (x))
 
@@ -42,4 +45,35 @@ namespace MathUtils
    ofVec2f Normal(ofVec2f v);
    float Curve(float t, float curve);
    int HighestPow2(int n);
+
+   //polynomial approximations for per-sample gain computation
+   //FastLog2() is within 2e-5 of log2f() (~0.0001dB), x must be positive
+   inline float FastLog2(float x)
+   {
+      uint32_t bits;
+      memcpy(&bits, &x, sizeof(bits));
+      float exponent = float(int((bits >> 23) & 0xff) - 127);
+      bits = (bits & 0x007fffff) | 0x3f800000;
+      float m;
+      memcpy(&m, &bits, sizeof(m));
+      m -= 1;
+      return exponent + (1.43909293e-05f + m * (1.44159208f + m * (-0.707253434f + m * (0.411561483f + m * (-0.189832447f + m * 0.0439286281f)))));
+   }
+
+   //FastExp2() is within a relative 4e-6 of exp2f() (~0.00003dB)
+   inline float FastExp2(float x)
+   {
+      x = ofClamp(x, -126, 126);
+      float whole = floorf(x);
+      float f = x - whole;
+      uint32_t bits = uint32_t(int(whole) + 127) << 23;
+      float scale;
+      memcpy(&scale, &bits, sizeof(scale));
+      return scale * (1.0000036f + f * (0.692969551f + f * (0.241621323f + f * (0.0517177355f + f * 0.0136839829f))));
+   }
+
+   //20 * log10(2), for converting between log2 and dB
+   const float kDbPerLog2 = 6.0205999f;
+   inline float FastLin2dB(float lin) { return FastLog2(lin) * kDbPerLog2; }
+   inline float FastdB2Lin(float dB) { return FastExp2(dB * (1.0f / kDbPerLog2)); }
 };
@@ -93,6 +93,7 @@ MidiController::MidiController()
 , mLayoutWidth(0)
 , mLayoutHeight(0)
 {
+   SetPollRate(kMaxPollRate);
    mListeners.resize(MAX_MIDI_PAGES);
 }
 
@@ -146,10 +147,12 @@ void MidiController::Init()
    for (auto i = mConnections.begin(); i != mConnections.end(); ++i)
       delete *i;
    mConnections.clear();
+   RebuildConnectionIndex();
 
    mHasCreatedConnectionUIControls = false;
    for (int i = 0; i < mConnectionsJson.size(); ++i)
       AddControlConnection(mConnectionsJson[i]);
+   RebuildConnectionIndex();
 
    TheTransport->AddAudioPoller(this);
 }
@@ -201,6 +204,7 @@ UIControlConnection* MidiController::AddControlConnection(MidiMessageType messag
 
    connection->CreateUIControls((int)mConnections.size());
    mConnections.push_back(connection);
+   mConnectionsChanged = true;
    if (uicontrol != nullptr)
       uicontrol->AddRemoteController();
 
@@ -304,6 +308,7 @@ void MidiController::AddControlConnection(const ofxJSONElement& connection)
 
       //controlConnection->CreateUIControls(this, mConnections.size()); //do this on the first draw instead, to avoid a long init time when setting up a bunch of minimized controllers
       mConnections.push_back(controlConnection);
+      mConnectionsChanged = true;
 
       if (!connection["pages"].isNull())
       {
@@ -333,71 +338,87 @@ void MidiController::OnTransportAdvanced(float amount)
 {
    PROFILER(MidiController);
 
-   mQueuedMessageMutex.lock();
+   //track the offset from the device clock to the audio clock. the callback doesn't come in at perfectly even
+   //intervals, so smooth it out, and start over if the audio clock jumps
+   double deviceToAudioClockMs = gTime - Time::getMillisecondCounterHiRes();
+   if (!mHasDeviceClock || std::abs(deviceToAudioClockMs - mDeviceToAudioClockMs) > 100)
+      mDeviceToAudioClockMs = deviceToAudioClockMs;
+   else
+      mDeviceToAudioClockMs += (deviceToAudioClockMs - mDeviceToAudioClockMs) * .05;
+   mHasDeviceClock = true;
 
    double firstNoteTimestampMs = -1;
    double lastPlayTime = -1;
-   for (auto note = mQueuedNotes.begin(); note != mQueuedNotes.end(); ++note)
+   QueuedMidiMessage message;
+   while (mQueuedMessages.consume(message))
    {
       int voiceIdx = -1;
 
       if (mUseChannelAsVoice)
-         voiceIdx = note->mChannel - 1;
+         voiceIdx = message.mChannel - 1;
 
-      //TODO(Ryan) how can I use note->mTimestamp to get more accurate timing for midi input?
-      //this here is not accurate, but prevents notes played within the same buffer from having the exact same time
-      double playTime;
-      if (firstNoteTimestampMs == -1) //this is the first note
+      if (message.mType == kMidiMessage_Note)
       {
-         firstNoteTimestampMs = note->mTimestampMs;
-         playTime = gTime;
+         double playTime;
+         if (mConstantLatencyInput)
+         {
+            //everything that came in during the last buffer lands at the same spot in this one, so notes keep
+            //their timing exactly, at the cost of a buffer of extra latency
+            const double kCallbackJitterMs = 1;
+            playTime = message.mTimestampMs + mDeviceToAudioClockMs + gBufferSizeMs + kCallbackJitterMs;
+            if (playTime < gTime)
+               playTime = gTime;
+            if (playTime <= lastPlayTime)
+               playTime = lastPlayTime + .01;
+         }
+         else if (firstNoteTimestampMs == -1) //this is the first note
+         {
+            //this is not accurate, but prevents notes played within the same buffer from having the exact same time
+            firstNoteTimestampMs = message.mTimestampMs;
+            playTime = gTime;
+         }
+         else
+         {
+            playTime = gTime + (message.mTimestampMs - firstNoteTimestampMs);
+            if (playTime <= lastPlayTime)
+               playTime += .01; //hack to handle note on/off in the same frame
+         }
+         lastPlayTime = playTime;
+         PlayNoteOutput(playTime, message.mData + mNoteOffset, MIN(127, message.mValue * mVelocityMult), voiceIdx, ModulationParameters(mModulation.GetPitchBend(voiceIdx), mModulation.GetModWheel(voiceIdx), mModulation.GetPressure(voiceIdx), 0));
+
+         MidiNote note{ message.mDeviceName, message.mTimestampMs, message.mData, message.mValue, message.mChannel };
+         for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
+            (*i)->OnMidiNote(note);
       }
-      else
+      else if (message.mType == kMidiMessage_Control)
       {
-         playTime = gTime + (note->mTimestampMs - firstNoteTimestampMs);
-         if (playTime <= lastPlayTime)
-            playTime += .01; //hack to handle note on/off in the same frame
-      }
-      lastPlayTime = playTime;
-      PlayNoteOutput(playTime, note->mPitch + mNoteOffset, MIN(127, note->mVelocity * mVelocityMult), voiceIdx, ModulationParameters(mModulation.GetPitchBend(voiceIdx), mModulation.GetModWheel(voiceIdx), mModulation.GetPressure(voiceIdx), 0));
-
-      for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
-         (*i)->OnMidiNote(*note);
-   }
-   mQueuedNotes.clear();
+         if (mSendCCOutput)
+            SendCCOutput(message.mData, message.mValue, voiceIdx);
 
-   for (auto ctrl = mQueuedControls.begin(); ctrl != mQueuedControls.end(); ++ctrl)
-   {
-      if (mSendCCOutput)
+         MidiControl control{ message.mDeviceName, message.mData, message.mValue, message.mChannel };
+         for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
+            (*i)->OnMidiControl(control);
+      }
+      else if (message.mType == kMidiMessage_Program)
       {
-         int voiceIdx = -1;
-
-         if (mUseChannelAsVoice)
-            voiceIdx = ctrl->mChannel - 1;
-
-         SendCCOutput(ctrl->mControl, ctrl->mValue, voiceIdx);
+         MidiProgramChange program{ message.mDeviceName, message.mData, message.mChannel };
+         for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
+            (*i)->OnMidiProgramChange(program);
+      }
+      else if (message.mType == kMidiMessage_PitchBend)
+      {
+         MidiPitchBend pitchBend{ message.mDeviceName, message.mValue, message.mChannel };
+         for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
+            (*i)->OnMidiPitchBend(pitchBend);
       }
-
-      for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
-         (*i)->OnMidiControl(*ctrl);
-   }
-   mQueuedControls.clear();
-
-   for (auto note = mQueuedProgramChanges.begin(); note != mQueuedProgramChanges.end(); ++note)
-   {
-      for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
-         (*i)->OnMidiProgramChange(*note);
-   }
-   mQueuedProgramChanges.clear();
-
-   for (auto note = mQueuedPitchBends.begin(); note != mQueuedPitchBends.end(); ++note)
-   {
-      for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
-         (*i)->OnMidiPitchBend(*note);
    }
-   mQueuedPitchBends.clear();
+}
 
-   mQueuedMessageMutex.unlock();
+void MidiController::QueueMessage(const QueuedMidiMessage& message)
+{
+   std::lock_guard<ofMutex> lock(mQueuedMessageWriteMutex);
+   if (!mQueuedMessages.produce(message))
+      ++mNumDroppedMessages; //the audio thread isn't keeping up
 }
 
 void MidiController::OnMidiNote(MidiNote& note)
@@ -413,9 +434,15 @@ void MidiController::OnMidiNote(MidiNote& note)
 
    MidiReceived(kMidiMessage_Note, note.mPitch, note.mVelocity / 127.0f, note.mVelocity, note.mChannel);
 
-   mQueuedMessageMutex.lock();
-   mQueuedNotes.push_back(note);
-   mQueuedMessageMutex.unlock();
+   QueuedMidiMessage message;
+   message.mType = kMidiMessage_Note;
+   message.mDeviceName = note.mDeviceName;
+   double now = Time::getMillisecondCounterHiRes();
+   message.mTimestampMs = std::abs(note.mTimestampMs - now) < 1000 ? note.mTimestampMs : now; //not every source stamps notes with the same clock
+   message.mData = note.mPitch;
+   message.mValue = note.mVelocity;
+   message.mChannel = note.mChannel;
+   QueueMessage(message);
 
    if (mPrintInput)
       ofLog() << Name() << " note: " << note.mPitch << ", " << note.mVelocity;
@@ -441,9 +468,14 @@ void MidiController::OnMidiControl(MidiControl& control)
 
    MidiReceived(kMidiMessage_Control, control.mControl, control.mValue / 127.0f, control.mValue, control.mChannel);
 
-   mQueuedMessageMutex.lock();
-   mQueuedControls.push_back(control);
-   mQueuedMessageMutex.unlock();
+   QueuedMidiMessage message;
+   message.mType = kMidiMessage_Control;
+   message.mDeviceName = control.mDeviceName;
+   message.mTimestampMs = Time::getMillisecondCounterHiRes();
+   message.mData = control.mControl;
+   message.mValue = control.mValue;
+   message.mChannel = control.mChannel;
+   QueueMessage(message);
 
    if (mPrintInput)
       ofLog() << Name() << " control: " << control.mControl << ", " << control.mValue;
@@ -471,9 +503,13 @@ void MidiController::OnMidiProgramChange(MidiProgramChange& program)
 
    MidiReceived(kMidiMessage_Program, program.mProgram, 1, 1, program.mChannel);
 
-   mQueuedMessageMutex.lock();
-   mQueuedProgramChanges.push_back(program);
-   mQueuedMessageMutex.unlock();
+   QueuedMidiMessage message;
+   message.mType = kMidiMessage_Program;
+   message.mDeviceName = program.mDeviceName;
+   message.mTimestampMs = Time::getMillisecondCounterHiRes();
+   message.mData = program.mProgram;
+   message.mChannel = program.mChannel;
+   QueueMessage(message);
 
    if (mPrintInput)
       ofLog() << Name() << " program change: " << program.mProgram;
@@ -497,9 +533,13 @@ void MidiController::OnMidiPitchBend(MidiPitchBend& pitchBend)
 
    MidiReceived(kMidiMessage_PitchBend, MIDI_PITCH_BEND_CONTROL_NUM, pitchBend.mValue / 16383.0f, pitchBend.mValue, pitchBend.mChannel); //16383 = max pitch bend
 
-   mQueuedMessageMutex.lock();
-   mQueuedPitchBends.push_back(pitchBend);
-   mQueuedMessageMutex.unlock();
+   QueuedMidiMessage message;
+   message.mType = kMidiMessage_PitchBend;
+   message.mDeviceName = pitchBend.mDeviceName;
+   message.mTimestampMs = Time::getMillisecondCounterHiRes();
+   message.mValue = pitchBend.mValue;
+   message.mChannel = pitchBend.mChannel;
+   QueueMessage(message);
 
    if (mPrintInput)
       ofLog() << Name() << " pitch bend: " << pitchBend.mValue;
@@ -569,9 +609,11 @@ void MidiController::MidiReceived(MidiMessageType messageType, int control, floa
       return;
    }
 
-   for (auto i = mConnections.begin(); i != mConnections.end(); ++i)
+   auto connectionIndex = std::atomic_load(&mConnectionIndex);
+   auto indexed = connectionIndex->find(GetConnectionIndexKey(messageType, control));
+   const std::vector<UIControlConnection*> kNoConnections;
+   for (UIControlConnection* connection : indexed != connectionIndex->end() ? indexed->second : kNoConnections)
    {
-      UIControlConnection* connection = *i;
       if (connection->mMessageType == messageType &&
           (connection->mControl == control || messageType == kMidiMessage_PitchBend) &&
           (connection->mPageless || connection->mPage == mControllerPage) &&
@@ -698,6 +740,32 @@ void MidiController::AddScriptListener(ScriptModule* script)
       mScriptListeners.push_back(script);
 }
 
+//static
+int MidiController::GetConnectionIndexKey(MidiMessageType messageType, int control)
+{
+   if (messageType == kMidiMessage_PitchBend)
+      control = 0; //pitch bend connections match any control
+   return messageType * 65536 + control;
+}
+
+//incoming messages are routed through an index of connections by message type and control, so big
+//mappings don't have to be searched for every message. feedback only looks at the current page
+void MidiController::RebuildConnectionIndex()
+{
+   auto connectionIndex = std::make_shared<ConnectionIndex>();
+   for (auto* connection : mConnections)
+      (*connectionIndex)[GetConnectionIndexKey(connection->mMessageType, connection->mControl)].push_back(connection);
+   std::atomic_store(&mConnectionIndex, std::shared_ptr<const ConnectionIndex>(connectionIndex));
+
+   mFeedbackConnections.clear();
+   for (auto* connection : mConnections)
+   {
+      if (connection->mTwoWay && connection->mFeedbackControl != -2 && (connection->mPageless || connection->mPage == mControllerPage))
+         mFeedbackConnections.push_back(connection);
+   }
+   mFeedbackConnectionsPage = mControllerPage;
+}
+
 void MidiController::RemoveConnection(int control, MidiMessageType messageType, int channel, int page)
 {
    IUIControl* removed = nullptr;
@@ -707,8 +775,10 @@ void MidiController::RemoveConnection(int control, MidiMessageType messageType,
       if ((*i)->mControl == control && (*i)->mMessageType == messageType && (*i)->mChannel == channel && ((*i)->mPage == page || (*i)->mPageless))
       {
          removed = (*i)->mUIControl;
-         delete *i;
-         i = mConnections.erase(i);
+         UIControlConnection* connection = *i;
+         mConnections.erase(i);
+         RebuildConnectionIndex(); //before deleting, so incoming messages can't find it
+         delete connection;
          break;
       }
    }
@@ -786,12 +856,16 @@ void MidiController::Poll()
       }
    }
 
+   if (mConnectionsChanged || mFeedbackConnectionsPage != mControllerPage)
+   {
+      RebuildConnectionIndex();
+      mConnectionsChanged = false;
+   }
+
    if (mTwoWay)
    {
-      for (auto i = mConnections.begin(); i != mConnections.end(); ++i)
+      for (UIControlConnection* connection : mFeedbackConnections)
       {
-         UIControlConnection* connection = *i;
-
          if (connection->mTwoWay == false)
             continue;
 
@@ -899,6 +973,7 @@ void MidiController::Poll()
       }
    }
 
+   mDevice.FlushFeedback();
    if (mNonstandardController != nullptr)
       mNonstandardController->Poll();
 
@@ -1003,6 +1078,8 @@ void MidiController::DrawModule()
       GetDimensions(w, h);
 
       DrawTextNormal("last input: " + mLastInput, 60, h - 5);
+      if (mNumDroppedMessages > 0)
+         DrawTextNormal("dropped " + ofToString(mNumDroppedMessages.load()) + " messages", 60, h - 17);
 
       if (gTime - mLastActivityTime > 0 && gTime - mLastActivityTime < 200)
       {
@@ -1423,6 +1500,7 @@ int MidiController::GetNumConnectionsOnPage(int page)
    return i;
 }
 
+//goes through the feedback queue like everything else, so feedback that's still queued for these controls gets replaced rather than sent after the zeros
 void MidiController::SetEntirePageToZero(int page)
 {
    for (auto iter = mConnections.begin(); iter != mConnections.end(); ++iter)
@@ -1430,10 +1508,11 @@ void MidiController::SetEntirePageToZero(int page)
       UIControlConnection* connection = *iter;
       if (connection->mPage == page && connection->mPageless == false)
       {
+         int channel = connection->mChannel == -1 ? mOutChannel : connection->mChannel;
          if (connection->mMessageType == kMidiMessage_Control)
-            mDevice.SendCC(connection->mControl, 0, connection->mChannel);
+            mDevice.QueueFeedback(MidiMessage::controllerEvent(channel, connection->mControl, 0));
          if (connection->mMessageType == kMidiMessage_Note)
-            mDevice.SendNote(gTime, connection->mControl, 0, false, connection->mChannel);
+            mDevice.QueueFeedback(MidiMessage::noteOff(channel, connection->mControl));
       }
    }
 }
@@ -1485,7 +1564,10 @@ void MidiController::SendNote(int page, int pitch, int velocity, bool forceNoteO
 
    if (page == mControllerPage)
    {
-      mDevice.SendNote(gTime, pitch, velocity, forceNoteOn, channel);
+      if (velocity > 0 || forceNoteOn)
+         mDevice.QueueFeedback(MidiMessage::noteOn(channel, pitch, (uint8)velocity));
+      else
+         mDevice.QueueFeedback(MidiMessage::noteOff(channel, pitch));
 
       if (mNonstandardController)
          mNonstandardController->SendValue(page, pitch, velocity / 127.0f, forceNoteOn, channel);
@@ -1499,7 +1581,7 @@ void MidiController::SendCC(int page, int ctl, int value, int channel /*= -1*/)
 
    if (page == mControllerPage)
    {
-      mDevice.SendCC(ctl, value, channel);
+      mDevice.QueueFeedback(MidiMessage::controllerEvent(channel, ctl, value));
 
       if (mNonstandardController)
          mNonstandardController->SendValue(page, ctl, value / 127.0f, channel);
@@ -1530,7 +1612,7 @@ void MidiController::SendData(int page, unsigned char a, unsigned char b, unsign
 {
    if (page == mControllerPage)
    {
-      mDevice.SendData(a, b, c);
+      mDevice.QueueFeedback(MidiMessage(a, b, c));
    }
 }
 
@@ -1538,7 +1620,7 @@ void MidiController::SendSysEx(int page, std::string data)
 {
    if (page == mControllerPage)
    {
-      mDevice.SendSysEx(data);
+      mDevice.QueueFeedback(MidiMessage::createSysExMessage(data.c_str(), (int)data.length()));
    }
 }
 
@@ -1840,6 +1922,7 @@ void MidiController::OnDeviceChanged()
 
 void MidiController::CheckboxUpdated(Checkbox* checkbox)
 {
+   mConnectionsChanged = true; //might have been a connection's editor control
    for (auto iter = mConnections.begin(); iter != mConnections.end(); ++iter)
    {
       UIControlConnection* connection = *iter;
@@ -1879,6 +1962,7 @@ void MidiController::ButtonClicked(ClickButton* button)
       if (button == connection->mRemoveButton)
       {
          mConnections.remove(connection);
+         RebuildConnectionIndex();
          delete connection;
          break;
       }
@@ -1887,6 +1971,7 @@ void MidiController::ButtonClicked(ClickButton* button)
          UIControlConnection* copy = connection->MakeCopy();
          copy->CreateUIControls((int)mConnections.size());
          mConnections.push_back(copy); //make a copy of this one
+         mConnectionsChanged = true;
          break;
       }
    }
@@ -1894,6 +1979,7 @@ void MidiController::ButtonClicked(ClickButton* button)
 
 void MidiController::DropdownUpdated(DropdownList* list, int oldVal)
 {
+   mConnectionsChanged = true; //might have been a connection's editor control
    if (list == mPageSelector)
    {
       SetEntirePageToZero(oldVal);
@@ -1988,6 +2074,7 @@ void MidiController::TextEntryActivated(TextEntry* entry)
 
 void MidiController::TextEntryComplete(TextEntry* entry)
 {
+   mConnectionsChanged = true; //might have been a connection's editor control
    for (auto iter = mConnections.begin(); iter != mConnections.end(); ++iter)
    {
       UIControlConnection* connection = *iter;
@@ -2080,6 +2167,7 @@ void MidiController::PostRepatch(PatchCableSource* cableSource, bool fromUserCli
            uiConnection->mUIControlPathInput[0] != 0))
       {
          mConnections.remove(uiConnection);
+         RebuildConnectionIndex();
          delete uiConnection;
       }
    }
@@ -2217,6 +2305,7 @@ void MidiController::ConnectDevice()
       if (dynamic_cast<OscController*>(mNonstandardController) == nullptr)
       {
          OscController* osc = new OscController(this, "", -1, mOscInPort);
+         osc->SetFeedbackRate(mModuleSaveData.GetFloat("feedback_messages_per_ms"));
          mNonstandardController = osc;
       }
    }
@@ -2293,6 +2382,8 @@ void MidiController::LoadLayout(const ofxJSONElement& moduleInfo)
    mModuleSaveData.LoadBool("twoway_on_change", moduleInfo, true);
    mModuleSaveData.LoadBool("resend_feedback_on_release", moduleInfo, false);
    mModuleSaveData.LoadBool("show_activity_ui_overlay", moduleInfo, true);
+   mModuleSaveData.LoadBool("constant_latency_input", moduleInfo, false);
+   mModuleSaveData.LoadFloat("feedback_messages_per_ms", moduleInfo, 3, 0, 100, K(isTextField));
 
    mConnectionsJson = moduleInfo["connections"];
 
@@ -2325,6 +2416,10 @@ void MidiController::SetUpFromSaveData()
    mSendTwoWayOnChange = mModuleSaveData.GetBool("twoway_on_change");
    mResendFeedbackOnRelease = mModuleSaveData.GetBool("resend_feedback_on_release");
    mShowActivityUIOverlay = mModuleSaveData.GetBool("show_activity_ui_overlay");
+   mConstantLatencyInput = mModuleSaveData.GetBool("constant_latency_input");
+   mDevice.SetFeedbackRate(mModuleSaveData.GetFloat("feedback_messages_per_ms"));
+   if (dynamic_cast<OscController*>(mNonstandardController) != nullptr)
+      dynamic_cast<OscController*>(mNonstandardController)->SetFeedbackRate(mModuleSaveData.GetFloat("feedback_messages_per_ms"));
 
    BuildControllerList();
 
@@ -38,6 +38,11 @@
 #include "TextEntry.h"
 #include "ModulationChain.h"
 #include "INoteSource.h"
+#include "LockFreeQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
 
 #define MIDI_PITCH_BEND_CONTROL_NUM 999
 #define MIDI_PAGE_WIDTH 1000
@@ -281,6 +286,17 @@ struct GridLayout
    GridControlTarget* mGridControlTarget[MAX_MIDI_PAGES];
 };
 
+//a message from the device, waiting for the audio thread to pick it up
+struct QueuedMidiMessage
+{
+   MidiMessageType mType{ kMidiMessage_Note };
+   const char* mDeviceName{ nullptr };
+   double mTimestampMs{ 0 };
+   int mData{ 0 }; //pitch, control or program
+   float mValue{ 0 }; //velocity, control value or pitch bend
+   int mChannel{ 0 };
+};
+
 #define NUM_LAYOUT_CONTROLS 128 + 128 + 128 + 1 + 1 //128 notes, 128 ccs, 128 program change, 1 pitch bend, 1 dummy
 
 class MidiController : public MidiDeviceListener, public IDrawableModule, public IButtonListener, public IDropdownListener, public IRadioButtonListener, public IAudioPoller, public ITextEntryListener, public INoteSource
@@ -427,10 +443,6 @@ private:
    bool mSendTwoWayOnChange;
    bool mResendFeedbackOnRelease;
    ClickButton* mAddConnectionButton{ nullptr };
-   std::list<MidiNote> mQueuedNotes;
-   std::list<MidiControl> mQueuedControls;
-   std::list<MidiProgramChange> mQueuedProgramChanges;
-   std::list<MidiPitchBend> mQueuedPitchBends;
    DropdownList* mControllerList;
    Checkbox* mDrawCablesCheckbox{ nullptr };
    MappingDisplayMode mMappingDisplayMode;
@@ -469,7 +481,21 @@ private:
    int mLayoutHeight;
    std::vector<GridLayout*> mGrids;
 
-   ofMutex mQueuedMessageMutex;
+   static int GetConnectionIndexKey(MidiMessageType messageType, int control);
+   void RebuildConnectionIndex();
+   using ConnectionIndex = std::unordered_map<int, std::vector<UIControlConnection*> >;
+   std::shared_ptr<const ConnectionIndex> mConnectionIndex{ std::make_shared<ConnectionIndex>() };
+   std::vector<UIControlConnection*> mFeedbackConnections;
+   std::atomic<int> mFeedbackConnectionsPage{ -1 };
+   std::atomic<bool> mConnectionsChanged{ false };
+
+   void QueueMessage(const QueuedMidiMessage& message);
+   LockFreeRingQueue<QueuedMidiMessage, 1024> mQueuedMessages;
+   ofMutex mQueuedMessageWriteMutex; //only the writers lock this, since messages can come in from the device, osc and ui threads
+   std::atomic<int> mNumDroppedMessages{ 0 };
+   bool mConstantLatencyInput{ false };
+   double mDeviceToAudioClockMs{ 0 };
+   bool mHasDeviceClock{ false };
 };
 
 #endif /* defined(__modularSynth__MidiController__) */
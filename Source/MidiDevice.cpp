@@ -27,6 +27,7 @@
 #include "SynthGlobals.h"
 #include "ModularSynth.h"
 
+#include <algorithm>
 #include <string.h>
 
 using namespace juce;
@@ -36,7 +37,11 @@ MidiDevice::MidiDevice(MidiDeviceListener* listener)
 , mMidiOut(nullptr)
 , mOutputChannel(1)
 , mIsInputEnabled(false)
+, mFeedbackQueue(kMaxQueuedFeedback)
+, mQueuedFeedbackByAddress(kNumFeedbackAddresses, -1)
+, mFeedbackLongData(kMaxQueuedLongDataBytes)
 {
+   mFeedbackToSend.ensureSize(kMaxQueuedFeedback * 8 + kMaxQueuedLongDataBytes);
 }
 
 MidiDevice::~MidiDevice()
@@ -119,6 +124,18 @@ void MidiDevice::DisconnectInput()
 
 void MidiDevice::DisconnectOutput()
 {
+   {
+      std::lock_guard<std::mutex> lock(mFeedbackMutex);
+      for (int i = 0; i < mFeedbackQueueCount; ++i)
+      {
+         const QueuedFeedback& queued = mFeedbackQueue[(mFeedbackQueueStart + i) % kMaxQueuedFeedback];
+         if (queued.mAddress != -1)
+            mQueuedFeedbackByAddress[queued.mAddress] = -1;
+      }
+      mFeedbackQueueStart = 0;
+      mFeedbackQueueCount = 0;
+      mFeedbackLongDataUsed = 0;
+   }
    if (mMidiOut)
       mMidiOut->stopBackgroundThread();
    mMidiOut.reset();
@@ -181,7 +198,7 @@ void MidiDevice::SendNote(double time, int pitch, int velocity, bool forceNoteOn
       if (channel == -1)
          channel = mOutputChannel;
 
-      int sampleNumber = (time - gTime) * gSampleRateMs;
+      int sampleNumber = GetBufferSampleIndex(time);
 
       juce::MidiBuffer midiBuffer;
 
@@ -259,7 +276,7 @@ void MidiDevice::SendMessage(double time, juce::MidiMessage message)
 {
    if (mMidiOut)
    {
-      int sampleNumber = (time - gTime) * gSampleRateMs;
+      int sampleNumber = GetBufferSampleIndex(time);
 
       juce::MidiBuffer midiBuffer;
       midiBuffer.addEvent(message, sampleNumber);
@@ -268,6 +285,120 @@ void MidiDevice::SendMessage(double time, juce::MidiMessage message)
    }
 }
 
+void MidiDevice::QueueFeedback(const MidiMessage& message)
+{
+   if (!mMidiOut)
+      return;
+
+   const uint8* data = message.getRawData();
+   int size = message.getRawDataSize();
+   bool isShort = !message.isSysEx() && size <= 3 && data[0] >= 0x80;
+
+   std::lock_guard<std::mutex> lock(mFeedbackMutex);
+
+   int address = -1;
+   if (isShort)
+   {
+      //note ons and offs share an address, so the latest one wins
+      int status = message.isNoteOff() ? (0x90 | (message.getChannel() - 1)) : data[0];
+      address = (status - 0x80) * 128 + (size > 1 ? data[1] & 0x7f : 0);
+      int slot = mQueuedFeedbackByAddress[address];
+      if (slot != -1)
+      {
+         mFeedbackQueue[slot].mSize = size;
+         std::copy(data, data + size, mFeedbackQueue[slot].mData);
+         return;
+      }
+   }
+
+   if (mFeedbackQueueCount == kMaxQueuedFeedback || (!isShort && mFeedbackLongDataUsed + size > kMaxQueuedLongDataBytes))
+   {
+      ++mNumDroppedFeedback;
+      return;
+   }
+
+   int slot = (mFeedbackQueueStart + mFeedbackQueueCount) % kMaxQueuedFeedback;
+   QueuedFeedback& queued = mFeedbackQueue[slot];
+   queued.mAddress = address;
+   queued.mSize = size;
+   if (isShort)
+   {
+      std::copy(data, data + size, queued.mData);
+      mQueuedFeedbackByAddress[address] = slot;
+   }
+   else
+   {
+      queued.mLongDataStart = mFeedbackLongDataUsed;
+      std::copy(data, data + size, mFeedbackLongData.begin() + mFeedbackLongDataUsed);
+      mFeedbackLongDataUsed += size;
+   }
+   ++mFeedbackQueueCount;
+}
+
+void MidiDevice::FlushFeedback()
+{
+   int numDropped = mNumDroppedFeedback.exchange(0);
+   if (numDropped > 0)
+      ofLog() << "midi feedback queue for " << mDeviceNameOut.toStdString() << " was full, dropped " << numDropped << " messages";
+
+   if (!mMidiOut)
+      return;
+
+   //take everything that fits in the budget under the lock, and send it once the audio thread can queue again.
+   //it all goes in one block, so backends can batch it into as few transfers as possible
+   mFeedbackToSend.clear();
+   {
+      std::lock_guard<std::mutex> lock(mFeedbackMutex);
+
+      if (mFeedbackQueueCount == 0)
+         return;
+
+      mFeedbackBudget.Refill();
+
+      while (mFeedbackQueueCount > 0)
+      {
+         const QueuedFeedback& queued = mFeedbackQueue[mFeedbackQueueStart];
+         if (!mFeedbackBudget.TrySpend(std::max(1, queued.mSize / 3)))
+            break;
+
+         if (queued.mAddress != -1)
+         {
+            mFeedbackToSend.addEvent(queued.mData, queued.mSize, 0);
+            mQueuedFeedbackByAddress[queued.mAddress] = -1;
+         }
+         else
+         {
+            mFeedbackToSend.addEvent(mFeedbackLongData.data() + queued.mLongDataStart, queued.mSize, 0);
+         }
+         mFeedbackQueueStart = (mFeedbackQueueStart + 1) % kMaxQueuedFeedback;
+         --mFeedbackQueueCount;
+      }
+
+      if (mFeedbackQueueCount == 0)
+         mFeedbackLongDataUsed = 0;
+   }
+
+   if (!mFeedbackToSend.isEmpty())
+      mMidiOut->sendBlockOfMessagesNow(mFeedbackToSend);
+}
+
+void OutputBudget::Refill()
+{
+   double time = Time::getMillisecondCounterHiRes();
+   mAvailable = std::min(float(mAvailable + (time - mLastRefillTime) * mRate), float(mRate * kMaxBurstMs));
+   mLastRefillTime = time;
+}
+
+bool OutputBudget::TrySpend(float numMessages)
+{
+   if (mRate <= 0)
+      return true;
+   if (mAvailable < numMessages && mAvailable < mRate * kMaxBurstMs) //a sysex bigger than a whole burst still has to go out eventually
+      return false;
+   mAvailable -= numMessages;
+   return true;
+}
+
 void MidiDevice::handleIncomingMidiMessage(MidiInput* source, const MidiMessage& message)
 {
    if (TheSynth->IsReady() == false)
@@ -31,6 +31,9 @@
 
 #include "juce_audio_devices/juce_audio_devices.h"
 
+#include <atomic>
+#include <mutex>
+
 struct MidiNote
 {
    const char* mDeviceName;
@@ -83,6 +86,24 @@ public:
    virtual void OnMidi(const juce::MidiMessage& message) {}
 };
 
+//spreads out feedback output, so a burst of updates (a full page of lights, a control modulated at audio rate)
+//doesn't flood a device faster than it can take it. a rate of zero means no limit
+class OutputBudget
+{
+public:
+   void SetRate(float messagesPerMs) { mRate = messagesPerMs; }
+   float GetRate() const { return mRate; }
+   void Refill();
+   bool TrySpend(float numMessages);
+
+private:
+   static constexpr double kMaxBurstMs = 20; //about a frame's worth, so whatever a poll queued up can go out together
+
+   float mRate{ 0 };
+   float mAvailable{ 0 };
+   double mLastRefillTime{ 0 };
+};
+
 class MidiDevice : public juce::MidiInputCallback
 {
 public:
@@ -111,6 +132,11 @@ public:
    void SendData(unsigned char a, unsigned char b, unsigned char c);
    void SendMessage(double time, juce::MidiMessage message);
 
+   //for controller feedback: queued messages for the same note or cc replace each other, and FlushFeedback() sends them within the budget
+   void QueueFeedback(const juce::MidiMessage& message);
+   void FlushFeedback();
+   void SetFeedbackRate(float messagesPerMs) { mFeedbackBudget.SetRate(messagesPerMs); }
+
    static void SendMidiMessage(MidiDeviceListener* listener, const char* deviceName, const juce::MidiMessage& message);
 
 private:
@@ -123,6 +149,28 @@ private:
    MidiDeviceListener* mListener;
    int mOutputChannel;
    bool mIsInputEnabled;
+
+   //feedback can be queued from the audio thread, so the queue lives in storage allocated up front
+   struct QueuedFeedback
+   {
+      int mAddress{ -1 }; //-1 for sysex and other long messages, which always go out in order
+      int mSize{ 0 };
+      juce::uint8 mData[3]{};
+      int mLongDataStart{ 0 }; //into mFeedbackLongData, for messages that don't fit in mData
+   };
+   static const int kMaxQueuedFeedback = 1024;
+   static const int kNumFeedbackAddresses = 128 * 128; //status bytes 0x80-0xff, by first data byte
+   static const int kMaxQueuedLongDataBytes = 8192;
+   std::vector<QueuedFeedback> mFeedbackQueue; //a ring, in the order each address was first queued
+   int mFeedbackQueueStart{ 0 };
+   int mFeedbackQueueCount{ 0 };
+   std::vector<int> mQueuedFeedbackByAddress; //slot in mFeedbackQueue, -1 if nothing's queued
+   std::vector<juce::uint8> mFeedbackLongData;
+   int mFeedbackLongDataUsed{ 0 };
+   std::atomic<int> mNumDroppedFeedback{ 0 };
+   juce::MidiBuffer mFeedbackToSend; //only FlushFeedback() touches this, so it can send outside the lock
+   OutputBudget mFeedbackBudget;
+   std::mutex mFeedbackMutex;
 };
 
 #endif /* defined(__additiveSynth__MidiDevice__) */
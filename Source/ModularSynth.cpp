@@ -37,6 +37,9 @@
 #include "EffectChain.h"
 #include "ClickButton.h"
 #include "UserPrefs.h"
+#include "OutputRecorder.h"
+#include "SampleCache.h"
+#include "LoopPagePool.h"
 
 #include "juce_audio_processors/juce_audio_processors.h"
 
@@ -76,7 +79,8 @@ void AtExit()
 ModularSynth::ModularSynth()
 : mMoveModule(nullptr)
 , mIsMousePanning(false)
-, mGlobalRecordBuffer(nullptr)
+, mRecentOutputBuffer(nullptr)
+, mOutputRecorder(nullptr)
 , mAudioPaused(false)
 , mIsLoadingState(false)
 , mClickStartX(INT_MAX)
@@ -88,7 +92,6 @@ ModularSynth::ModularSynth()
 , mLastClickedModule(nullptr)
 , mMinimap(nullptr)
 , mInitialized(false)
-, mRecordingLength(0)
 , mGroupSelectContext(nullptr)
 , mResizeModule(nullptr)
 , mShowLoadStatePopup(false)
@@ -121,9 +124,8 @@ ModularSynth::~ModularSynth()
 {
    DeleteAllModules();
 
-   delete mGlobalRecordBuffer;
-   delete[] mSaveOutputBuffer[0];
-   delete[] mSaveOutputBuffer[1];
+   delete mOutputRecorder;
+   delete mRecentOutputBuffer;
    mAudioPluginFormatManager.reset();
    mKnownPluginList.reset();
 
@@ -261,10 +263,9 @@ void ModularSynth::Setup(juce::AudioDeviceManager* globalAudioDeviceManager, juc
 
    mIOBufferSize = gBufferSize;
 
-   mGlobalRecordBuffer = new RollingBuffer(UserPrefs.record_buffer_length_minutes.Get() * 60 * gSampleRate);
-   mGlobalRecordBuffer->SetNumChannels(2);
-   mSaveOutputBuffer[0] = new float[mGlobalRecordBuffer->Size()];
-   mSaveOutputBuffer[1] = new float[mGlobalRecordBuffer->Size()];
+   mRecentOutputBuffer = new RollingBuffer(gSampleRate / 10);
+   mRecentOutputBuffer->SetNumChannels(2);
+   mOutputRecorder = new OutputRecorder((long long)(UserPrefs.record_buffer_length_minutes.Get() * 60 * gSampleRate), 2);
 
    juce::File(ofToDataPath("savestate")).createDirectory();
    juce::File(ofToDataPath("savestate/autosave")).createDirectory();
@@ -378,6 +379,8 @@ void ModularSynth::Poll()
       mUILayerModuleContainer.Poll();
    }
 
+   LoopPagePool::Get()->Poll();
+
    if (mShowLoadStatePopup)
    {
       mShowLoadStatePopup = false;
@@ -515,7 +518,7 @@ void ModularSynth::Draw(void* vg)
    }
 
    if (UserPrefs.draw_background_lissajous.Get())
-      DrawLissajous(mGlobalRecordBuffer, 0, 0, ofGetWidth(), ofGetHeight(), sBackgroundLissajousR, sBackgroundLissajousG, sBackgroundLissajousB);
+      DrawLissajous(mRecentOutputBuffer, 0, 0, ofGetWidth(), ofGetHeight(), sBackgroundLissajousR, sBackgroundLissajousG, sBackgroundLissajousB);
 
    if (gTime == 1 && mFatalError == "")
    {
@@ -574,6 +577,7 @@ void ModularSynth::Draw(void* vg)
       float moduleX, moduleY;
       mLissajousDrawers[i]->GetPosition(moduleX, moduleY);
       IAudioSource* source = dynamic_cast<IAudioSource*>(mLissajousDrawers[i]);
+      source->GetVizBuffer()->Watch();
       DrawLissajous(source->GetVizBuffer(), moduleX, moduleY - 240, 240, 240);
    }
 
@@ -1787,6 +1791,7 @@ void ModularSynth::MouseReleased(int intX, int intY, int button, const juce::Mou
       {
          float moduleX, moduleY;
          module->GetPosition(moduleX, moduleY);
+         mHeldSample->FinishLoading();
          module->SampleDropped(x - moduleX, y - moduleY, GetHeldSample());
       }
       ClearHeldSample();
@@ -1878,11 +1883,10 @@ void ModularSynth::AudioOut(float** output, int bufferSize, int nChannels)
    }
    /////////// AUDIO PROCESSING ENDS HERE /////////////
    if (nChannels >= 1)
-      mGlobalRecordBuffer->WriteChunk(output[0], bufferSize, 0);
+      mRecentOutputBuffer->WriteChunk(output[0], bufferSize, 0);
    if (nChannels >= 2)
-      mGlobalRecordBuffer->WriteChunk(output[1], bufferSize, 1);
-   mRecordingLength += bufferSize;
-   mRecordingLength = MIN(mRecordingLength, mGlobalRecordBuffer->Size());
+      mRecentOutputBuffer->WriteChunk(output[1], bufferSize, 1);
+   mOutputRecorder->Write(output, nChannels, bufferSize);
 
    Profiler::PrintCounters();
 }
@@ -2395,7 +2399,7 @@ void ModularSynth::GrabSample(std::string filePath)
 {
    delete mHeldSample;
    mHeldSample = new Sample();
-   mHeldSample->Read(filePath.c_str());
+   mHeldSample->Read(filePath.c_str(), false, Sample::ReadType::Async);
 }
 
 void ModularSynth::ClearHeldSample()
@@ -2793,6 +2797,12 @@ void ModularSynth::OnConsoleInput()
       {
          DumpStats(false, nullptr);
       }
+      else if (tokens[0] == "samplecache")
+      {
+         if (tokens.size() > 1 && tokens[1] == "clear")
+            SampleCache::Get()->Clear();
+         LogEvent(SampleCache::Get()->GetStatsString(), kLogEventType_Verbose);
+      }
       else
       {
          ofLog() << "Creating: " << mConsoleText;
@@ -3005,8 +3015,6 @@ void ModularSynth::ReconnectMidiDevices()
 
 void ModularSynth::SaveOutput()
 {
-   ScopedMutex mutex(&mAudioThreadMutex, "SaveOutput()");
-
    std::string save_prefix = "recording_";
    if (!mCurrentSaveStatePath.empty())
    {
@@ -3018,21 +3026,9 @@ void ModularSynth::SaveOutput()
    std::string filename = ofGetTimestampString(UserPrefs.recordings_path.Get() + save_prefix + "%Y-%m-%d_%H-%M.wav");
    //string filenamePos = ofGetTimestampString("recordings/pos_%Y-%m-%d_%H-%M.wav");
 
-   assert(mRecordingLength <= mGlobalRecordBuffer->Size());
-
-   for (int i = 0; i < mRecordingLength; ++i)
-   {
-      mSaveOutputBuffer[0][i] = mGlobalRecordBuffer->GetSample((int)mRecordingLength - i - 1, 0);
-      mSaveOutputBuffer[1][i] = mGlobalRecordBuffer->GetSample((int)mRecordingLength - i - 1, 1);
-   }
-
-   Sample::WriteDataToFile(filename, mSaveOutputBuffer, (int)mRecordingLength, 2);
-
-   //mOutputBufferMeasurePos.ReadChunk(mSaveOutputBuffer, mRecordingLength);
-   //Sample::WriteDataToFile(filenamePos.c_str(), mSaveOutputBuffer, mRecordingLength, 1);
-
-   mGlobalRecordBuffer->ClearBuffer();
-   mRecordingLength = 0;
+   //streams the recorded range out of the recorder's scratch file, so audio keeps running
+   mOutputRecorder->SaveRecording(filename);
+   mRecentOutputBuffer->ClearBuffer();
 }
 
 const String& ModularSynth::GetTextFromClipboard() const
@@ -43,6 +43,7 @@ class QuickSpawnMenu;
 class ADSRDisplay;
 class UserPrefsEditor;
 class Minimap;
+class OutputRecorder;
 
 enum LogEventType
 {
@@ -336,8 +337,8 @@ private:
    std::unique_ptr<Minimap> mMinimap;
    UserPrefsEditor* mUserPrefsEditor;
 
-   RollingBuffer* mGlobalRecordBuffer;
-   long long mRecordingLength;
+   RollingBuffer* mRecentOutputBuffer;
+   OutputRecorder* mOutputRecorder;
 
    struct LogEventItem
    {
@@ -373,8 +374,6 @@ private:
 
    Sample* mHeldSample;
 
-   float* mSaveOutputBuffer[2];
-
    IDrawableModule* mLastClickedModule;
    bool mInitialized;
 
@@ -25,6 +25,11 @@
 
 #include "ModulationChain.h"
 
+#include <algorithm>
+
+//static
+std::atomic<uint64_t> ModulationChain::sChangeStamp{ 0 };
+
 ModulationChain::ModulationChain()
 : mLFOAmount(0)
 , mPrev(nullptr)
@@ -33,6 +38,7 @@ ModulationChain::ModulationChain()
 , mBuffer(nullptr)
 {
    mLFO.SetMode(kLFOMode_Oscillator);
+   mBlock.reserve(gBufferSize); //so GetBlock() doesn't allocate on the audio thread
 }
 
 float ModulationChain::GetValue(int samplesIn) const
@@ -49,6 +55,54 @@ float ModulationChain::GetValue(int samplesIn) const
    return value;
 }
 
+//the most recent change to this chain, or to any chain it reads from. stamps only ever go up, so this moves whenever any of them change
+uint64_t ModulationChain::GetLatestChangeStamp() const
+{
+   uint64_t stamp = mChangeStamp;
+   if (mMultiplyIn)
+      stamp = std::max(stamp, mMultiplyIn->mChangeStamp.load());
+   if (mSidechain)
+      stamp = std::max(stamp, mSidechain->mChangeStamp.load());
+   if (mPrev)
+      stamp = std::max(stamp, mPrev->GetLatestChangeStamp());
+   return stamp;
+}
+
+//renders the whole chain for the current buffer the first time it's asked for, so voices reading the same chain
+//don't each walk it for every sample. the chains this one appends to get rendered first. audio thread only
+const float* ModulationChain::GetBlock()
+{
+   uint64_t changeStamp = GetLatestChangeStamp();
+   if (mBlockTime != gTime || mBlockChangeStamp != changeStamp || (int)mBlock.size() != gBufferSize)
+   {
+      mBlock.resize(gBufferSize);
+      const float* prevBlock = mPrev ? mPrev->GetBlock() : nullptr;
+      for (int i = 0; i < gBufferSize; ++i)
+      {
+         float value = GetIndividualValue(i);
+         if (mMultiplyIn)
+            value *= mMultiplyIn->GetIndividualValue(i);
+         if (mSidechain)
+            value += mSidechain->GetIndividualValue(i);
+         if (prevBlock)
+            value += prevBlock[i];
+         if (value != value)
+            value = 0;
+         mBlock[i] = value;
+      }
+      mBlockTime = gTime;
+      mBlockChangeStamp = changeStamp;
+   }
+   return mBlock.data();
+}
+
+float ModulationChain::GetBlockValue(int samplesIn)
+{
+   if (samplesIn >= 0 && samplesIn < gBufferSize)
+      return GetBlock()[samplesIn];
+   return GetValue(samplesIn);
+}
+
 float ModulationChain::GetIndividualValue(int samplesIn) const
 {
    double time = gTime + gInvSampleRateMs * samplesIn;
@@ -67,32 +121,38 @@ float ModulationChain::GetIndividualValue(int samplesIn) const
 void ModulationChain::SetValue(float value)
 {
    mRamp.Start(gTime, value, gTime + gInvSampleRateMs * gBufferSize);
+   MarkChanged();
 }
 
 void ModulationChain::RampValue(double time, float from, float to, double length)
 {
    mRamp.Start(time, from, to, time + length);
+   MarkChanged();
 }
 
 void ModulationChain::SetLFO(NoteInterval interval, float amount)
 {
    mLFO.SetPeriod(interval);
    mLFOAmount = amount;
+   MarkChanged();
 }
 
 void ModulationChain::AppendTo(ModulationChain* chain)
 {
    mPrev = chain;
+   MarkChanged();
 }
 
 void ModulationChain::SetSidechain(ModulationChain* chain)
 {
    mSidechain = chain;
+   MarkChanged();
 }
 
 void ModulationChain::MultiplyIn(ModulationChain* chain)
 {
    mMultiplyIn = chain;
+   MarkChanged();
 }
 
 void ModulationChain::CreateBuffer()
@@ -100,12 +160,14 @@ void ModulationChain::CreateBuffer()
    if (mBuffer == nullptr)
       mBuffer = new float[gBufferSize];
    Clear(mBuffer, gBufferSize);
+   MarkChanged();
 }
 
 void ModulationChain::FillBuffer(float* buffer)
 {
    if (mBuffer != nullptr)
       BufferCopy(mBuffer, buffer, gBufferSize);
+   MarkChanged();
 }
 
 float ModulationChain::GetBufferValue(int sampleIdx)
@@ -116,9 +178,8 @@ float ModulationChain::GetBufferValue(int sampleIdx)
 }
 
 Modulations::Modulations(bool isGlobalEffect)
+: mVoiceModulations(kNumVoices) //chains can't be moved, so construct them in place rather than resizing
 {
-   mVoiceModulations.resize(kNumVoices);
-
    if (isGlobalEffect)
    {
       for (int i = 0; i < kNumVoices; ++i)
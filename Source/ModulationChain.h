@@ -29,12 +29,18 @@
 #include "Ramp.h"
 #include "LFO.h"
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
 class ModulationChain
 {
 public:
    ModulationChain();
    float GetValue(int samplesIn) const;
    float GetIndividualValue(int samplesIn) const;
+   const float* GetBlock();
+   float GetBlockValue(int samplesIn);
    void SetValue(float value);
    void RampValue(double time, float from, float to, double length);
    void SetLFO(NoteInterval interval, float amount);
@@ -46,6 +52,9 @@ public:
    float GetBufferValue(int sampleIdx);
 
 private:
+   void MarkChanged() { mChangeStamp = ++sChangeStamp; }
+   uint64_t GetLatestChangeStamp() const;
+
    Ramp mRamp;
    LFO mLFO;
    float mLFOAmount;
@@ -53,6 +62,14 @@ private:
    ModulationChain* mPrev;
    ModulationChain* mSidechain;
    ModulationChain* mMultiplyIn;
+
+   //GetValue() for every sample of the current buffer, shared by everything reading this chain on the audio thread.
+   //it's good for as long as gTime and the latest change to this chain or anything it reads from stay the same
+   std::vector<float> mBlock;
+   double mBlockTime{ -1 };
+   uint64_t mBlockChangeStamp{ 0 };
+   std::atomic<uint64_t> mChangeStamp{ 0 }; //written by whichever thread changes the chain, read on the audio thread. 64 bits, so it never wraps
+   static std::atomic<uint64_t> sChangeStamp;
 };
 
 struct ModulationCollection
@@ -0,0 +1,231 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ModuleRenderCache.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "juce_opengl/juce_opengl.h"
+using namespace juce::gl;
+
+#include "ModuleRenderCache.h"
+#include "IDrawableModule.h"
+#include "IUIControl.h"
+#include "ModularSynth.h"
+#include "Push2Control.h"
+#include "SynthGlobals.h"
+#include "TextEntry.h"
+#include "UserPrefs.h"
+#include "nanovg/nanovg.h"
+#include "nanovg/nanovg_gl_utils.h"
+
+namespace
+{
+   const int kStableFramesBeforeCaching = 10; //so modules that are being adjusted don't thrash their framebuffers
+   const int kMaxRendersPerFrame = 16;
+   const int kMaxFramebufferSize = 4096;
+   const long long kMaxCachedPixels = 32 * 1024 * 1024;
+   const float kMargin = 4; //room for the outline and input pips, which sit just outside the module
+}
+
+std::vector<ModuleRenderCache*> ModuleRenderCache::sQueue;
+std::vector<NVGLUframebuffer*> ModuleRenderCache::sFramebuffersToDelete;
+long long ModuleRenderCache::sNumCachedPixels = 0;
+ofMutex ModuleRenderCache::sMutex;
+float ModuleRenderCache::sPixelRatio = 1;
+bool ModuleRenderCache::sDrawingToCache = false;
+IDrawableModule* ModuleRenderCache::sHoveredModule = nullptr;
+IDrawableModule* ModuleRenderCache::sFocusedModule = nullptr;
+
+ModuleRenderCache::ModuleRenderCache(IDrawableModule* module)
+: mModule(module)
+{
+}
+
+ModuleRenderCache::~ModuleRenderCache()
+{
+   std::lock_guard<ofMutex> lock(sMutex);
+   RemoveFromVector(this, sQueue);
+   ReleaseFramebuffer();
+}
+
+bool ModuleRenderCache::Draw()
+{
+   if (!UserPrefs.cache_module_rendering.Get() || sDrawingToCache || Push2Control::sDrawingPush2Display || !mModule->CanCacheDrawing())
+      return false;
+
+   float xform[6];
+   nvgCurrentTransform(gNanoVG, xform);
+   float scale = xform[0];
+   size_t hash = 0;
+   if (xform[1] == 0 && xform[2] == 0 && xform[3] == scale)
+      hash = mModule->GetRenderHash();
+
+   if (hash == 0)
+   {
+      mSeenHash = 0;
+      mStableFrames = 0;
+      return false;
+   }
+
+   if (mFramebuffer != nullptr && hash == mHash && scale == mScale)
+   {
+      //composite in screen space, snapped to the pixel grid so the image doesn't get resampled
+      float moduleX, moduleY;
+      mModule->GetPosition(moduleX, moduleY, true);
+      float x = round((xform[4] + (moduleX + mBounds.x) * scale) * sPixelRatio) / sPixelRatio;
+      float y = round((xform[5] + (moduleY + mBounds.y) * scale) * sPixelRatio) / sPixelRatio;
+      float w = mFramebufferWidth / sPixelRatio;
+      float h = mFramebufferHeight / sPixelRatio;
+
+      nvgSave(gNanoVG);
+      nvgResetTransform(gNanoVG);
+      NVGpaint paint = nvgImagePattern(gNanoVG, x, y, w, h, 0, mFramebuffer->image, 1);
+      nvgBeginPath(gNanoVG);
+      nvgRect(gNanoVG, x, y, w, h);
+      nvgFillPaint(gNanoVG, paint);
+      nvgFill(gNanoVG);
+      nvgRestore(gNanoVG);
+      return true;
+   }
+
+   if (hash == mSeenHash && scale == mSeenScale)
+   {
+      ++mStableFrames;
+   }
+   else
+   {
+      mSeenHash = hash;
+      mSeenScale = scale;
+      mStableFrames = 0;
+   }
+
+   if (mStableFrames >= kStableFramesBeforeCaching && !mQueued)
+   {
+      std::lock_guard<ofMutex> lock(sMutex);
+      sQueue.push_back(this);
+      mQueued = true;
+   }
+
+   return false;
+}
+
+//static
+void ModuleRenderCache::BeginFrame(NVGcontext* vg, float pixelRatio)
+{
+   sPixelRatio = pixelRatio;
+
+   //modules under the mouse or taking keystrokes draw hover states and carets, so they always draw live
+   sHoveredModule = TheSynth->GetModuleAtCursor();
+   IUIControl* focusedControl = dynamic_cast<IUIControl*>(IKeyboardFocusListener::GetActiveKeyboardFocus());
+   sFocusedModule = focusedControl ? focusedControl->GetModuleParent() : nullptr;
+
+   std::lock_guard<ofMutex> lock(sMutex);
+
+   for (auto* framebuffer : sFramebuffersToDelete)
+      nvgluDeleteFramebuffer(framebuffer);
+   sFramebuffersToDelete.clear();
+
+   if (sQueue.empty())
+      return;
+
+   int numRendered = 0;
+   while (!sQueue.empty() && numRendered < kMaxRendersPerFrame)
+   {
+      ModuleRenderCache* cache = sQueue.front();
+      sQueue.erase(sQueue.begin());
+      cache->mQueued = false;
+      cache->RenderToFramebuffer(vg);
+      ++numRendered;
+   }
+
+   nvgluBindFramebuffer(nullptr);
+}
+
+//call with sMutex held
+void ModuleRenderCache::RenderToFramebuffer(NVGcontext* vg)
+{
+   float width, height;
+   mModule->GetDimensions(width, height);
+   float titleBarHeight = mModule->HasTitleBar() ? IDrawableModule::TitleBarHeight() : 0;
+   mBounds.set(-kMargin, -titleBarHeight - kMargin, width + kMargin * 2, height + titleBarHeight + kMargin * 2);
+
+   int framebufferWidth = (int)ceil(mBounds.width * mSeenScale * sPixelRatio);
+   int framebufferHeight = (int)ceil(mBounds.height * mSeenScale * sPixelRatio);
+   if (mFramebuffer != nullptr && (framebufferWidth != mFramebufferWidth || framebufferHeight != mFramebufferHeight))
+      ReleaseFramebuffer();
+
+   if (mFramebuffer == nullptr)
+   {
+      if (framebufferWidth <= 0 || framebufferHeight <= 0 || framebufferWidth > kMaxFramebufferSize || framebufferHeight > kMaxFramebufferSize ||
+          sNumCachedPixels + framebufferWidth * framebufferHeight > kMaxCachedPixels)
+         return;
+
+      mFramebuffer = nvgluCreateFramebuffer(vg, framebufferWidth, framebufferHeight, 0);
+      if (mFramebuffer == nullptr)
+         return;
+      mFramebufferWidth = framebufferWidth;
+      mFramebufferHeight = framebufferHeight;
+      sNumCachedPixels += mFramebufferWidth * mFramebufferHeight;
+   }
+
+   mHash = mModule->GetRenderHash();
+   mScale = mSeenScale;
+   if (mHash == 0)
+      return;
+
+   nvgluBindFramebuffer(mFramebuffer);
+   glViewport(0, 0, mFramebufferWidth, mFramebufferHeight);
+   glClearColor(0, 0, 0, 0);
+   glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+   nvgBeginFrame(vg, mFramebufferWidth / sPixelRatio, mFramebufferHeight / sPixelRatio, sPixelRatio);
+
+   //same setup as the main frame
+   nvgLineCap(vg, NVG_ROUND);
+   nvgLineJoin(vg, NVG_ROUND);
+   nvgTextLetterSpacing(vg, -.3f);
+
+   float moduleX, moduleY;
+   mModule->GetPosition(moduleX, moduleY, true);
+   nvgScale(vg, mScale, mScale);
+   nvgTranslate(vg, -(moduleX + mBounds.x), -(moduleY + mBounds.y));
+
+   sDrawingToCache = true;
+   mModule->RenderContents(width, height);
+   sDrawingToCache = false;
+
+   nvgEndFrame(vg);
+}
+
+//call with sMutex held
+void ModuleRenderCache::ReleaseFramebuffer()
+{
+   if (mFramebuffer == nullptr)
+      return;
+
+   //this can happen off the render thread, so the GL objects get cleaned up at the start of the next frame
+   sFramebuffersToDelete.push_back(mFramebuffer);
+   sNumCachedPixels -= mFramebufferWidth * mFramebufferHeight;
+   mFramebuffer = nullptr;
+   mHash = 0;
+}
@@ -0,0 +1,87 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ModuleRenderCache.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "OpenFrameworksPort.h"
+
+struct NVGcontext;
+struct NVGLUframebuffer;
+class IDrawableModule;
+
+template <typename T>
+void HashCombine(size_t& hash, const T& value)
+{
+   hash ^= std::hash<T>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+
+//draws a module from an offscreen image while nothing about it is changing.
+//each frame the module reports a hash of everything its drawing depends on (see IDrawableModule::GetRenderHash()).
+//once that has held steady for a few frames, the module gets drawn into a framebuffer before the main frame begins,
+//and that image is composited in its place until the hash or the zoom changes
+class ModuleRenderCache
+{
+public:
+   explicit ModuleRenderCache(IDrawableModule* module);
+   ~ModuleRenderCache();
+
+   bool Draw(); //returns false if the module needs to draw itself this frame
+
+   static void BeginFrame(NVGcontext* vg, float pixelRatio); //render thread, before the main nvgBeginFrame()
+   static bool IsDrawingToCache() { return sDrawingToCache; }
+   static IDrawableModule* GetHoveredModule() { return sHoveredModule; }
+   static IDrawableModule* GetFocusedModule() { return sFocusedModule; }
+
+private:
+   void RenderToFramebuffer(NVGcontext* vg);
+   void ReleaseFramebuffer();
+
+   IDrawableModule* mModule;
+   NVGLUframebuffer* mFramebuffer{ nullptr };
+   int mFramebufferWidth{ 0 };
+   int mFramebufferHeight{ 0 };
+   ofRectangle mBounds; //module-local area that the framebuffer covers
+   size_t mHash{ 0 }; //what's in the framebuffer
+   float mScale{ 0 };
+   size_t mSeenHash{ 0 }; //what we've been seeing while drawing live
+   float mSeenScale{ 0 };
+   int mStableFrames{ 0 };
+   bool mQueued{ false };
+
+   static std::vector<ModuleRenderCache*> sQueue;
+   static std::vector<NVGLUframebuffer*> sFramebuffersToDelete;
+   static long long sNumCachedPixels;
+   static ofMutex sMutex;
+   static float sPixelRatio;
+   static bool sDrawingToCache;
+   static IDrawableModule* sHoveredModule;
+   static IDrawableModule* sFocusedModule;
+};
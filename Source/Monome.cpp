@@ -287,6 +287,7 @@ void Monome::oscMessageReceived(const juce::OSCMessage& msg)
       note.mVelocity = val * 127.0f;
       note.mChannel = 0;
       note.mDeviceName = mPrefix.toUTF8();
+      note.mTimestampMs = juce::Time::getMillisecondCounterHiRes();
       mListener->OnMidiNote(note);
    }
    else if (label == "/" + mPrefix + "/tilt")
@@ -49,6 +49,9 @@ MultibandCompressor::MultibandCompressor()
    mOutBuffer = new float[GetBuffer()->BufferSize()];
    Clear(mOutBuffer, GetBuffer()->BufferSize());
 
+   for (int i = 0; i < COMPRESSOR_MAX_BANDS; ++i)
+      mBandGain[i] = 1;
+
    CalcFilters();
 }
 
@@ -85,19 +88,23 @@ void MultibandCompressor::Process(double time)
    {
       Clear(mOutBuffer, bufferSize);
 
-      for (int i = 0; i < bufferSize; ++i)
+      //split off one band at a time across the whole block, leaving the remaining highs in mWorkBuffer
+      BufferCopy(mWorkBuffer, GetBuffer()->GetChannel(0), bufferSize);
+      float* band = gWorkBuffer;
+      for (int j = 0; j < mNumBands; ++j)
       {
-         float lower;
-         float highLeftover = GetBuffer()->GetChannel(0)[i];
-         for (int j = 0; j < mNumBands; ++j)
-         {
-            mFilters[j].ProcessSample(highLeftover, lower, highLeftover);
-            mPeaks[j].Process(&lower, 1);
-            float compress = ofClamp(1 / mPeaks[i].GetPeak(), 0, 10);
-            mOutBuffer[i] += lower * compress;
-         }
-         mOutBuffer[i] += highLeftover;
+         for (int i = 0; i < bufferSize; ++i)
+            mFilters[j].ProcessSample(mWorkBuffer[i], band[i], mWorkBuffer[i]);
+
+         //band gain is computed once per block, and ramped to from the previous block's gain
+         mPeaks[j].Process(band, bufferSize);
+         float compress = ofClamp(1 / mPeaks[j].GetPeak(), 0, 10);
+         float gainStep = (compress - mBandGain[j]) / bufferSize;
+         for (int i = 0; i < bufferSize; ++i)
+            mOutBuffer[i] += band[i] * (mBandGain[j] + gainStep * i);
+         mBandGain[j] = compress;
       }
+      Add(mOutBuffer, mWorkBuffer, bufferSize);
 
       /*for (int i=0; i<mNumBands; ++i)
       {
@@ -90,6 +90,7 @@ private:
 
    CLinkwitzRiley_4thOrder mFilters[COMPRESSOR_MAX_BANDS];
    PeakTracker mPeaks[COMPRESSOR_MAX_BANDS];
+   float mBandGain[COMPRESSOR_MAX_BANDS];
 };
 
 #endif /* defined(__Bespoke__MultibandCompressor__) */
@@ -106,11 +106,35 @@ void MultitapDelay::Process(double time)
    for (int i = 0; i < bufferSize; ++i)
    {
       ComputeSliders(i);
+      for (int t = 0; t < mNumTaps; ++t)
+         mTaps[t].UpdateControls(i);
+   }
+
+   bool processAsBlock = true;
+   for (int t = 0; t < mNumTaps; ++t)
+   {
+      if (!mTaps[t].CanProcessBlock(bufferSize))
+         processAsBlock = false;
+   }
 
+   if (processAsBlock)
+   {
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
       {
          for (int t = 0; t < mNumTaps; ++t)
-            mTaps[t].Process(&mWriteBuffer.GetChannel(ch)[i], i, ch);
+            mTaps[t].ProcessBlock(mWriteBuffer.GetChannel(ch), bufferSize, ch);
+      }
+   }
+
+   for (int i = 0; i < bufferSize; ++i)
+   {
+      for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
+      {
+         if (!processAsBlock)
+         {
+            for (int t = 0; t < mNumTaps; ++t)
+               mTaps[t].Process(&mWriteBuffer.GetChannel(ch)[i], i, ch);
+         }
          for (int t = 0; t < kNumMPETaps; ++t)
             mMPETaps[t].Process(&mWriteBuffer.GetChannel(ch)[i], i, ch);
       }
@@ -258,11 +282,14 @@ void MultitapDelay::DelayMPETap::Process(float* sampleOut, int offset, int ch)
    /*if (!mADSR.IsDone(gTime) && sampleLength > 0)
    {
       double time = gTime;
+      const float* pitchBendBlock = mPitchBend ? mPitchBend->GetBlock() : nullptr;
+      const float* pressureBlock = mPressure ? mPressure->GetBlock() : nullptr;
+      const float* modWheelBlock = mModWheel ? mModWheel->GetBlock() : nullptr;
       for (int i=0; i<outLength; ++i)
       {
-         float pitchBend = mPitchBend ? mPitchBend->GetValue(i) : 0;
-         float pressure = mPressure ? mPressure->GetValue(i) : 0;
-         float modwheel = mModWheel ? mModWheel->GetValue(i) : 0;
+         float pitchBend = pitchBendBlock ? pitchBendBlock[i] : 0;
+         float pressure = pressureBlock ? pressureBlock[i] : 0;
+         float modwheel = modWheelBlock ? modWheelBlock[i] : 0;
          if (pressure > 0)
          {
             mGranulator.mGrainOverlap = ofMap(pressure * pressure, 0, 1, 3, MAX_GRAINS);
@@ -320,15 +347,38 @@ void MultitapDelay::DelayMPETap::Draw(float w, float h)
 
 MultitapDelay::DelayTap::DelayTap()
 : mTapBuffer(gBufferSize)
+, mDelaySampsBuffer(gBufferSize)
+, mGainBuffer(gBufferSize)
+, mFeedbackBuffer(gBufferSize)
+, mPanBuffer(gBufferSize)
 {
 }
 
+void MultitapDelay::DelayTap::UpdateControls(int offset)
+{
+   mDelaySampsBuffer[offset] = MIN(mDelayMs / gInvSampleRateMs, mOwner->mDelayBuffer.Size() - 2);
+   mGainBuffer[offset] = mGain;
+   mFeedbackBuffer[offset] = mFeedback;
+   mPanBuffer[offset] = mPan;
+}
+
+bool MultitapDelay::DelayTap::CanProcessBlock(int bufferSize) const
+{
+   //the whole block can be read up front if no read lands in this block, where the feedback from this block is being written.
+   //a read at sample i lands delay - bufferSize samples behind sample i, so it's clear of the block once the delay is two blocks long
+   for (int i = 0; i < bufferSize; ++i)
+   {
+      if (mGainBuffer[i] > 0 && mDelaySampsBuffer[i] < bufferSize * 2)
+         return false;
+   }
+   return true;
+}
+
 void MultitapDelay::DelayTap::Process(float* sampleOut, int offset, int ch)
 {
-   if (mGain > 0)
+   if (mGainBuffer[offset] > 0)
    {
-      float delaySamps = mDelayMs / gInvSampleRateMs;
-      delaySamps = ofClamp(delaySamps - offset, 0.1f, mOwner->mDelayBuffer.Size() - 2);
+      float delaySamps = ofClamp(mDelaySampsBuffer[offset] - offset, 0.1f, mOwner->mDelayBuffer.Size() - 2);
 
       int sampsAgoA = int(delaySamps);
       int sampsAgoB = sampsAgoA + 1;
@@ -338,13 +388,46 @@ void MultitapDelay::DelayTap::Process(float* sampleOut, int offset, int ch)
       float a = delaySamps - sampsAgoA;
       float delayedSample = (1 - a) * sample + a * nextSample; //interpolate
 
-      float outputSample = delayedSample * mGain;
+      float outputSample = delayedSample * mGainBuffer[offset];
       mTapBuffer.GetChannel(ch)[offset] = outputSample;
 
       *sampleOut += outputSample;
-      float panGain = ch == 0 ? GetLeftPanGain(mPan) : GetRightPanGain(mPan);
-      mOwner->mDelayBuffer.Accum(gBufferSize - offset, outputSample * mFeedback * panGain, ch);
+      float panGain = ch == 0 ? GetLeftPanGain(mPanBuffer[offset]) : GetRightPanGain(mPanBuffer[offset]);
+      mOwner->mDelayBuffer.Accum(gBufferSize - offset, outputSample * mFeedbackBuffer[offset] * panGain, ch);
+   }
+}
+
+void MultitapDelay::DelayTap::ProcessBlock(float* out, int bufferSize, int ch)
+{
+   bool isStatic = true;
+   bool isSilent = true;
+   for (int i = 0; i < bufferSize; ++i)
+   {
+      if (mDelaySampsBuffer[i] != mDelaySampsBuffer[0])
+         isStatic = false;
+      if (mGainBuffer[i] > 0)
+         isSilent = false;
    }
+
+   if (isSilent)
+      return;
+
+   float* tapOut = mTapBuffer.GetChannel(ch);
+   if (isStatic)
+      mOwner->mDelayBuffer.ReadChunkDelayed(tapOut, bufferSize, mDelaySampsBuffer[0], ch);
+   else
+      mOwner->mDelayBuffer.ReadChunkDelayed(tapOut, bufferSize, mDelaySampsBuffer.data(), ch);
+
+   float* feedback = gWorkBuffer;
+   for (int i = 0; i < bufferSize; ++i)
+   {
+      tapOut[i] *= MAX(mGainBuffer[i], 0);
+      float panGain = ch == 0 ? GetLeftPanGain(mPanBuffer[i]) : GetRightPanGain(mPanBuffer[i]);
+      feedback[i] = tapOut[i] * mFeedbackBuffer[i] * panGain;
+   }
+
+   Add(out, tapOut, bufferSize);
+   mOwner->mDelayBuffer.AccumChunk(feedback, bufferSize, 0, ch);
 }
 
 void MultitapDelay::DelayTap::Draw(float w, float h)
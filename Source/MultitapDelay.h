@@ -89,7 +89,10 @@ private:
    struct DelayTap
    {
       DelayTap();
+      void UpdateControls(int offset);
+      bool CanProcessBlock(int bufferSize) const;
       void Process(float* sampleOut, int offset, int ch);
+      void ProcessBlock(float* out, int bufferSize, int ch);
       void Draw(float w, float h);
 
       float mDelayMs{ 100 };
@@ -105,6 +108,12 @@ private:
       FloatSlider* mPanSlider{ nullptr };
 
       ChannelBuffer mTapBuffer;
+
+      //per-sample control values for the current block
+      std::vector<float> mDelaySampsBuffer;
+      std::vector<float> mGainBuffer;
+      std::vector<float> mFeedbackBuffer;
+      std::vector<float> mPanBuffer;
    };
 
    struct DelayMPETap
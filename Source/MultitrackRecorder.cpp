@@ -28,7 +28,6 @@
 #include "Profiler.h"
 #include "SynthGlobals.h"
 #include "Transport.h"
-#include "Sample.h"
 #include "UIControlMacros.h"
 #include "PatchCableSource.h"
 #include "UserPrefs.h"
@@ -128,19 +127,21 @@ void MultitrackRecorder::ButtonClicked(ClickButton* button)
 
    if (button == mBounceButton)
    {
+      if (mRecord)
+      {
+         mStatusString = "stop recording before bouncing";
+         mStatusStringTime = gTime;
+         return;
+      }
+
       std::string filenamePrefix = ofGetTimestampString(UserPrefs.recordings_path.Get() + "multitrack_%Y-%m-%d_%H-%M_");
 
       int numFiles = 0;
       for (int i = 0; i < (int)mTracks.size(); ++i)
       {
-         Sample* sample = mTracks[i]->BounceRecording();
-
-         if (sample)
-         {
-            std::string filename = filenamePrefix + ofToString(i + 1) + ".wav";
-            sample->Write(filename.c_str());
+         std::string filename = filenamePrefix + ofToString(i + 1) + ".wav";
+         if (mTracks[i]->WriteRecordingTo(filename))
             ++numFiles;
-         }
       }
 
       if (numFiles > 0)
@@ -259,8 +260,48 @@ void MultitrackRecorder::LoadState(FileStreamIn& in)
 
 namespace
 {
-   const int kRecordingChunkSize = 48000 * 5;
-   const int kMinRecordingChunks = 2;
+   const int kWriteIntervalMs = 50;
+
+   bool PopChunkIndex(juce::AbstractFifo& fifo, const int* indices, int& index)
+   {
+      int start1, size1, start2, size2;
+      fifo.prepareToRead(1, start1, size1, start2, size2);
+      if (size1 == 0)
+         return false;
+      index = indices[start1];
+      fifo.finishedRead(1);
+      return true;
+   }
+
+   void PushChunkIndex(juce::AbstractFifo& fifo, int* indices, int index)
+   {
+      int start1, size1, start2, size2;
+      fifo.prepareToWrite(1, start1, size1, start2, size2);
+      assert(size1 == 1); //there is room for every chunk in both fifos
+      indices[start1] = index;
+      fifo.finishedWrite(1);
+   }
+};
+
+class MultitrackRecorderTrack::WriterThread : public juce::Thread
+{
+public:
+   WriterThread(MultitrackRecorderTrack* track)
+   : juce::Thread("MultitrackRecorderTrack")
+   , mTrack(track)
+   {}
+
+   void run() override
+   {
+      while (!threadShouldExit())
+      {
+         mTrack->WriteFilledChunks();
+         wait(kWriteIntervalMs);
+      }
+   }
+
+private:
+   MultitrackRecorderTrack* mTrack;
 };
 
 MultitrackRecorderTrack::MultitrackRecorderTrack()
@@ -270,6 +311,10 @@ MultitrackRecorderTrack::MultitrackRecorderTrack()
 
 MultitrackRecorderTrack::~MultitrackRecorderTrack()
 {
+   if (mWriterThread)
+      mWriterThread->stopThread(1000);
+   mWriter.reset();
+   mTempFile.deleteFile();
 }
 
 void MultitrackRecorderTrack::CreateUIControls()
@@ -285,54 +330,77 @@ void MultitrackRecorderTrack::CreateUIControls()
 
 void MultitrackRecorderTrack::Process(double time)
 {
-   int numChannels = GetBuffer()->NumActiveChannels();
-   for (size_t i = 0; i < mRecordChunks.size(); ++i)
-   {
-      if (mRecordChunks[i]->NumActiveChannels() > numChannels)
-         numChannels = mRecordChunks[i]->NumActiveChannels();
-   }
+   int numChannels = MAX(GetBuffer()->NumActiveChannels(), mNumRecordedChannels);
 
    ComputeSliders(0);
    SyncBuffers(numChannels);
 
+   if (mResetCurrentChunk.exchange(false) && mCurrentChunk != -1)
+   {
+      mRecordChunks[mCurrentChunk].mLength = 0;
+      mHasPartialChunk = false;
+   }
+
+   int bufferSize = GetBuffer()->BufferSize();
    if (mDoRecording)
    {
-      for (size_t i = 0; i < mRecordChunks.size(); ++i)
-         mRecordChunks[i]->SetNumActiveChannels(numChannels);
+      mNumRecordedChannels = numChannels;
 
-      for (int i = 0; i < GetBuffer()->BufferSize(); ++i)
+      int pos = 0;
+      while (pos < bufferSize)
       {
-         int chunkIndex = mRecordingLength / kRecordingChunkSize;
-         int chunkPos = mRecordingLength % kRecordingChunkSize;
-         for (int ch = 0; ch < numChannels; ++ch)
-            mRecordChunks[chunkIndex]->GetChannel(ch)[chunkPos] = GetBuffer()->GetChannel(MIN(ch, GetBuffer()->NumActiveChannels() - 1))[i];
-         ++mRecordingLength;
+         if (mCurrentChunk == -1 && !PopChunkIndex(mFreeChunkFifo, mFreeChunks, mCurrentChunk))
+         {
+            //writer thread fell behind. keep time moving, the gap gets written as silence
+            mNumDroppedSamples += bufferSize - pos;
+            mRecordingLength += bufferSize - pos;
+            break;
+         }
+
+         RecordChunk& chunk = mRecordChunks[mCurrentChunk];
+         if (chunk.mLength == 0)
+         {
+            chunk.mStart = mRecordingLength;
+            chunk.mNumChannels = numChannels;
+         }
+
+         int length = MIN(bufferSize - pos, kRecordingChunkSize - chunk.mLength);
+         for (int ch = 0; ch < ChannelBuffer::kMaxNumChannels; ++ch)
+            BufferCopy(chunk.mBuffer.GetChannel(ch) + chunk.mLength, GetBuffer()->GetChannel(MIN(ch, GetBuffer()->NumActiveChannels() - 1)) + pos, length);
+         chunk.mNumChannels = MAX(chunk.mNumChannels, numChannels);
+         chunk.mLength += length;
+         mRecordingLength += length;
+         pos += length;
+
+         if (chunk.mLength == kRecordingChunkSize)
+            PushCurrentChunk();
+         else
+            mHasPartialChunk = true;
       }
    }
+   else if (mCurrentChunk != -1 && mRecordChunks[mCurrentChunk].mLength > 0)
+   {
+      PushCurrentChunk(); //hand over what we have, so it can be bounced
+   }
 
    if (GetTarget())
    {
       for (int ch = 0; ch < GetTarget()->GetBuffer()->NumActiveChannels(); ++ch)
       {
          float* buffer = GetBuffer()->GetChannel(MIN(ch, GetBuffer()->NumActiveChannels() - 1));
-         Add(GetTarget()->GetBuffer()->GetChannel(ch), buffer, GetBuffer()->BufferSize());
-         GetVizBuffer()->WriteChunk(buffer, GetBuffer()->BufferSize(), MIN(ch, GetVizBuffer()->NumChannels() - 1));
+         Add(GetTarget()->GetBuffer()->GetChannel(ch), buffer, bufferSize);
+         GetVizBuffer()->WriteChunk(buffer, bufferSize, MIN(ch, GetVizBuffer()->NumChannels() - 1));
       }
    }
 
    GetBuffer()->Reset();
 }
 
-void MultitrackRecorderTrack::Poll()
+void MultitrackRecorderTrack::PushCurrentChunk()
 {
-   IDrawableModule::Poll();
-
-   int chunkIndex = mRecordingLength / kRecordingChunkSize;
-   if (chunkIndex >= (int)mRecordChunks.size() - 1)
-   {
-      mRecordChunks.push_back(new ChannelBuffer(kRecordingChunkSize));
-      mRecordChunks[mRecordChunks.size() - 1]->GetChannel(0); //set up buffer
-   }
+   PushChunkIndex(mFilledChunkFifo, mFilledChunks, mCurrentChunk);
+   mCurrentChunk = -1;
+   mHasPartialChunk = false;
 }
 
 void MultitrackRecorderTrack::DrawModule()
@@ -357,16 +425,29 @@ void MultitrackRecorderTrack::DrawModule()
       ofRect(0, 0, sampleWidth, height - 6);
    }
 
-   ofPushMatrix();
-   int numChunks = mRecordingLength / kRecordingChunkSize + 1;
-   float chunkWidth = sampleWidth / numChunks;
-   for (int i = 0; i < numChunks; ++i)
    {
-      if (i < (int)mRecordChunks.size())
-         DrawAudioBuffer(chunkWidth, height - 6, mRecordChunks[i], 0, kRecordingChunkSize, -1);
-      ofTranslate(chunkWidth, 0);
+      std::lock_guard<std::mutex> lock(mOverviewMutex);
+      int numBlocks = (int)mOverview.size();
+      int totalBlocks = mRecordingLength / kOverviewBlockSize + 1;
+      float centerY = (height - 6) / 2;
+      ofSetColor(255, 255, 255, gModuleDrawAlpha);
+      for (int x = 0; x < (int)sampleWidth; ++x)
+      {
+         int startBlock = int(x * totalBlocks / sampleWidth);
+         int endBlock = MIN(MAX(int((x + 1) * totalBlocks / sampleWidth), startBlock + 1), numBlocks);
+         float peak = 0;
+         for (int i = startBlock; i < endBlock; ++i)
+            peak = MAX(peak, mOverview[i]);
+         if (peak > 0)
+            ofLine(x, centerY - peak * centerY, x, centerY + peak * centerY);
+      }
+   }
+
+   if (mNumDroppedSamples > 0)
+   {
+      ofSetColor(255, 0, 0, gModuleDrawAlpha);
+      DrawTextNormal("dropped " + ofToString(mNumDroppedSamples.load()) + " samples", 5, height - 12);
    }
-   ofPopMatrix();
 
    ofPopMatrix();
 }
@@ -377,66 +458,150 @@ void MultitrackRecorderTrack::Setup(MultitrackRecorder* recorder, int minLength)
    mRecordingLength = minLength;
 }
 
+void MultitrackRecorderTrack::AllocateChunks()
+{
+   if (mChunksAllocated)
+      return;
+
+   for (int i = 0; i < kNumRecordingChunks; ++i)
+   {
+      mRecordChunks[i].mBuffer.SetNumActiveChannels(ChannelBuffer::kMaxNumChannels);
+      for (int ch = 0; ch < ChannelBuffer::kMaxNumChannels; ++ch)
+         mRecordChunks[i].mBuffer.GetChannel(ch); //set up buffer
+      PushChunkIndex(mFreeChunkFifo, mFreeChunks, i);
+   }
+
+   mWriterThread = std::make_unique<WriterThread>(this);
+   mWriterThread->startThread();
+
+   mChunksAllocated = true;
+}
+
 void MultitrackRecorderTrack::SetRecording(bool record)
 {
    if (record)
    {
-      if (mRecordingLength == 0)
+      AllocateChunks();
+      mDoRecording = true;
+   }
+   else
+   {
+      mDoRecording = false;
+   }
+}
+
+void MultitrackRecorderTrack::WriteFilledChunks()
+{
+   std::lock_guard<std::mutex> lock(mWriterMutex);
+   WriteFilledChunksLocked();
+}
+
+void MultitrackRecorderTrack::WriteFilledChunksLocked()
+{
+   int index;
+   while (PopChunkIndex(mFilledChunkFifo, mFilledChunks, index))
+   {
+      RecordChunk& chunk = mRecordChunks[index];
+
+      if (mWriter == nullptr)
       {
-         mRecordingLength = 0;
+         mTempFile = juce::File::getSpecialLocation(juce::File::tempDirectory).getNonexistentChildFile("bespoke_multitrack", ".wav", false);
+         auto outputTo = mTempFile.createOutputStream();
+         if (outputTo != nullptr)
+         {
+            juce::WavAudioFormat wavFormat;
+            mWriter.reset(wavFormat.createWriterFor(outputTo.release(), gSampleRate, chunk.mNumChannels, 16, {}, 0));
+         }
+      }
+
+      if (mWriter != nullptr)
+      {
+         float* data[ChannelBuffer::kMaxNumChannels];
+         for (int ch = 0; ch < ChannelBuffer::kMaxNumChannels; ++ch)
+            data[ch] = chunk.mBuffer.GetChannel(ch);
 
-         for (size_t i = mRecordChunks.size(); i < kMinRecordingChunks; ++i)
+         //fill gaps (dropped samples, or a track added partway through) with silence to stay aligned
+         if (chunk.mStart > mWrittenLength)
          {
-            mRecordChunks.push_back(new ChannelBuffer(kRecordingChunkSize));
-            mRecordChunks[i]->GetChannel(0); //set up buffer
+            float* silence[ChannelBuffer::kMaxNumChannels];
+            std::vector<float> zeros(kRecordingChunkSize, 0);
+            for (int ch = 0; ch < ChannelBuffer::kMaxNumChannels; ++ch)
+               silence[ch] = zeros.data();
+            while (chunk.mStart > mWrittenLength)
+               WriteToFile(silence, (int)mWriter->getNumChannels(), MIN(chunk.mStart - mWrittenLength, kRecordingChunkSize));
          }
 
-         for (size_t i = 0; i < mRecordChunks.size(); ++i)
-            mRecordChunks[i]->Clear();
+         WriteToFile(data, (int)mWriter->getNumChannels(), chunk.mLength);
       }
 
-      mDoRecording = true;
-   }
-   else
-   {
-      mDoRecording = false;
+      chunk.mLength = 0;
+      PushChunkIndex(mFreeChunkFifo, mFreeChunks, index);
    }
 }
 
-Sample* MultitrackRecorderTrack::BounceRecording()
+void MultitrackRecorderTrack::WriteToFile(float** data, int numChannels, int length)
 {
-   Sample* sample = nullptr;
-   if (mRecordingLength > 0)
+   mWriter->writeFromFloatArrays(data, numChannels, length);
+   mWrittenLength += length;
+
+   std::lock_guard<std::mutex> lock(mOverviewMutex);
+   for (int i = 0; i < length; ++i)
    {
-      sample = new Sample();
-      sample->Create(mRecordingLength);
-      ChannelBuffer* data = sample->Data();
-      int channelCount = mRecordChunks[0]->NumActiveChannels();
-      data->SetNumActiveChannels(channelCount);
-
-      int numChunks = mRecordingLength / kRecordingChunkSize + 1;
-      for (int i = 0; i < numChunks; ++i)
+      for (int ch = 0; ch < numChannels; ++ch)
+         mOverviewPeak = MAX(mOverviewPeak, fabsf(data[ch][i]));
+      if (++mOverviewBlockPos == kOverviewBlockSize)
       {
-         int samplesLeftToRecord = mRecordingLength - i * kRecordingChunkSize;
-         int samplesToCopy;
-         if (samplesLeftToRecord > kRecordingChunkSize)
-            samplesToCopy = kRecordingChunkSize;
-         else
-            samplesToCopy = samplesLeftToRecord;
-         for (int ch = 0; ch < channelCount; ++ch)
-            BufferCopy(data->GetChannel(ch) + i * kRecordingChunkSize, mRecordChunks[i]->GetChannel(ch), samplesToCopy);
+         mOverview.push_back(MIN(mOverviewPeak, 1));
+         mOverviewPeak = 0;
+         mOverviewBlockPos = 0;
       }
    }
+}
 
-   return sample;
+bool MultitrackRecorderTrack::WriteRecordingTo(const std::string& path)
+{
+   if (mDoRecording)
+      return false; //the take is still growing
+
+   //the audio thread hands its last partial chunk over on the first block after recording stops, wait for that so the end of the take isn't cut off
+   for (int i = 0; i < kPartialChunkWaitMs && mHasPartialChunk; ++i)
+      juce::Thread::sleep(1);
+   if (mHasPartialChunk)
+      return false;
+
+   std::lock_guard<std::mutex> lock(mWriterMutex);
+   WriteFilledChunksLocked();
+
+   if (mWriter == nullptr || mWrittenLength == 0)
+      return false;
+
+   //the take is already on disk, bring the header up to date and copy it across
+   mWriter->flush();
+   return mTempFile.copyFileTo(juce::File(ofToDataPath(path)));
 }
 
 void MultitrackRecorderTrack::Clear()
 {
-   for (auto* recordChunk : mRecordChunks)
-      delete recordChunk;
-   mRecordChunks.clear();
+   std::lock_guard<std::mutex> lock(mWriterMutex);
+
+   int index;
+   while (PopChunkIndex(mFilledChunkFifo, mFilledChunks, index))
+   {
+      mRecordChunks[index].mLength = 0;
+      PushChunkIndex(mFreeChunkFifo, mFreeChunks, index);
+   }
+   mResetCurrentChunk = true;
+
+   mWriter.reset();
+   mTempFile.deleteFile();
+   mWrittenLength = 0;
    mRecordingLength = 0;
+   mNumDroppedSamples = 0;
+
+   std::lock_guard<std::mutex> overviewLock(mOverviewMutex);
+   mOverview.clear();
+   mOverviewPeak = 0;
+   mOverviewBlockPos = 0;
 }
 
 void MultitrackRecorderTrack::FloatSliderUpdated(FloatSlider* slider, float oldVal)
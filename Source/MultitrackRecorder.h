@@ -34,6 +34,11 @@
 #include "IAudioProcessor.h"
 #include "ModuleContainer.h"
 
+#include <atomic>
+#include <mutex>
+
+#include "juce_audio_formats/juce_audio_formats.h"
+
 class MultitrackRecorderTrack;
 
 class MultitrackRecorder : public IDrawableModule, public IButtonListener
@@ -99,14 +104,14 @@ public:
    void CreateUIControls() override;
    bool HasTitleBar() const override { return false; }
 
-   void Poll() override;
    void Process(double time) override;
 
    void Setup(MultitrackRecorder* recorder, int minLength);
    void SetRecording(bool record);
-   Sample* BounceRecording();
+   bool WriteRecordingTo(const std::string& path);
    void Clear();
    int GetRecordingLength() const { return mRecordingLength; }
+   void WriteFilledChunks();
 
    void FloatSliderUpdated(FloatSlider* slider, float oldVal) override;
    void CheckboxUpdated(Checkbox* checkbox) override;
@@ -120,10 +125,54 @@ private:
    void DrawModule() override;
    void GetModuleDimensions(float& width, float& height) override;
 
+   void AllocateChunks();
+   void PushCurrentChunk();
+   void WriteFilledChunksLocked();
+   void WriteToFile(float** data, int numChannels, int length);
+
+   class WriterThread;
+
+   static const int kRecordingChunkSize = 32768;
+   static const int kNumRecordingChunks = 16;
+   static const int kOverviewBlockSize = 1024;
+   static const int kPartialChunkWaitMs = 200;
+
+   struct RecordChunk
+   {
+      ChannelBuffer mBuffer{ kRecordingChunkSize };
+      int mStart{ 0 };
+      int mLength{ 0 };
+      int mNumChannels{ 1 };
+   };
+
    MultitrackRecorder* mRecorder{ nullptr };
 
-   std::vector<ChannelBuffer*> mRecordChunks;
-   bool mDoRecording{ false };
+   //the audio thread fills chunks from the free queue and hands them to the writer thread through the filled queue
+   RecordChunk mRecordChunks[kNumRecordingChunks];
+   bool mChunksAllocated{ false };
+   juce::AbstractFifo mFreeChunkFifo{ kNumRecordingChunks + 1 };
+   int mFreeChunks[kNumRecordingChunks + 1]{};
+   juce::AbstractFifo mFilledChunkFifo{ kNumRecordingChunks + 1 };
+   int mFilledChunks[kNumRecordingChunks + 1]{};
+   int mCurrentChunk{ -1 };
+   std::atomic<bool> mResetCurrentChunk{ false };
+   std::atomic<bool> mHasPartialChunk{ false }; //mCurrentChunk holds samples that haven't been handed to the writer thread yet
+   std::atomic<int> mNumDroppedSamples{ 0 };
+   int mNumRecordedChannels{ 1 };
+
+   //owned by the writer thread
+   std::unique_ptr<WriterThread> mWriterThread;
+   std::mutex mWriterMutex;
+   juce::File mTempFile;
+   std::unique_ptr<juce::AudioFormatWriter> mWriter;
+   int mWrittenLength{ 0 };
+
+   std::mutex mOverviewMutex;
+   std::vector<float> mOverview; //peak per kOverviewBlockSize samples, for drawing
+   float mOverviewPeak{ 0 };
+   int mOverviewBlockPos{ 0 };
+
+   std::atomic<bool> mDoRecording{ false };
    int mRecordingLength{ 0 };
    ClickButton* mDeleteButton{ nullptr };
 };
@@ -182,6 +182,7 @@ void NoteCanvas::KeyPressed(int key, bool isRepeat)
                element->mCol = ofClamp(element->mCol + directionLeftRight, 0, mCanvas->GetNumCols() - 1);
             }
          }
+         mCanvas->MarkElementsMoved();
       }
       else
       {
@@ -612,6 +613,7 @@ void NoteCanvas::QuantizeNotes()
          element->mOffset = 0;
       }
    }
+   mCanvas->MarkElementsMoved();
 }
 
 void NoteCanvas::LoadMidi()
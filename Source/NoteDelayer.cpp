@@ -31,6 +31,7 @@
 
 NoteDelayer::NoteDelayer()
 {
+   mDueNotes.reserve(mInputNotes.GetCapacity());
 }
 
 void NoteDelayer::Init()
@@ -70,6 +71,9 @@ void NoteDelayer::DrawModule()
       ofCircle(54 + sin(t * TWO_PI) * 10, 11 - cos(t * TWO_PI) * 10, 2);
       ofPopStyle();
    }
+
+   if (GetNumDroppedNotes() > 0)
+      DrawTextNormal("dropped " + ofToString(GetNumDroppedNotes()) + " notes", 4, 34);
 }
 
 void NoteDelayer::CheckboxUpdated(Checkbox* checkbox)
@@ -77,8 +81,7 @@ void NoteDelayer::CheckboxUpdated(Checkbox* checkbox)
    if (checkbox == mEnabledCheckbox)
    {
       mNoteOutput.Flush(gTime);
-      mAppendIndex = 0;
-      mConsumeIndex = 0;
+      mWantClear = true;
    }
 }
 
@@ -88,18 +91,30 @@ void NoteDelayer::OnTransportAdvanced(float amount)
 
    ComputeSliders(0);
 
-   int end = mAppendIndex;
-   if (mAppendIndex < mConsumeIndex)
-      end += kQueueSize;
-   for (int i = mConsumeIndex; i < end; ++i)
+   NoteInfo incoming;
+   while (mIncomingNotes.consume(incoming))
+      mInputNotes.Push(incoming.mTriggerTime, incoming, incoming.mVelocity == 0 ? 0 : 1);
+   if (mWantClear.exchange(false))
+      mInputNotes.Clear();
+
+   //the output could feed back into us, so pull everything that's due before playing any of it
+   mDueNotes.clear();
+   while (!mInputNotes.IsEmpty() && gTime + gBufferSizeMs >= mInputNotes.GetNextTime())
    {
-      const NoteInfo& info = mInputNotes[i % kQueueSize];
-      if (gTime + gBufferSizeMs >= info.mTriggerTime)
+      const NoteInfo& info = mInputNotes.GetNext();
+      if (info.mPitch >= 0 && info.mPitch <= 127)
       {
-         PlayNoteOutput(info.mTriggerTime, info.mPitch, info.mVelocity, -1, info.mModulation);
-         mConsumeIndex = (mConsumeIndex + 1) % kQueueSize;
+         NoteInputElement note;
+         note.time = info.mTriggerTime;
+         note.pitch = info.mPitch;
+         note.velocity = info.mVelocity;
+         note.modulation = info.mModulation;
+         mDueNotes.push_back(note);
       }
+      mInputNotes.PopNext();
    }
+
+   PlayNoteOutputBlock(mDueNotes);
 }
 
 void NoteDelayer::PlayNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation)
@@ -110,16 +125,15 @@ void NoteDelayer::PlayNote(double time, int pitch, int velocity, int voiceIdx, M
    if (velocity > 0)
       mLastNoteOnTime = time;
 
-   if ((mAppendIndex + 1) % kQueueSize != mConsumeIndex)
-   {
-      NoteInfo info;
-      info.mPitch = pitch;
-      info.mVelocity = velocity;
-      info.mTriggerTime = time + mDelay / (float(TheTransport->GetTimeSigTop()) / TheTransport->GetTimeSigBottom()) * TheTransport->MsPerBar();
-      info.mModulation = modulation;
-      mInputNotes[mAppendIndex] = info;
-      mAppendIndex = (mAppendIndex + 1) % kQueueSize;
-   }
+   NoteInfo info;
+   info.mPitch = pitch;
+   info.mVelocity = velocity;
+   info.mTriggerTime = time + mDelay / (float(TheTransport->GetTimeSigTop()) / TheTransport->GetTimeSigBottom()) * TheTransport->MsPerBar();
+   info.mModulation = modulation;
+
+   std::lock_guard<ofMutex> lock(mIncomingNotesWriteMutex);
+   if (!mIncomingNotes.produce(info))
+      ++mNumDroppedIncomingNotes; //the audio thread isn't keeping up
 }
 
 void NoteDelayer::FloatSliderUpdated(FloatSlider* slider, float oldVal)
@@ -32,6 +32,8 @@
 #include "INoteSource.h"
 #include "Slider.h"
 #include "Transport.h"
+#include "TimedEventQueue.h"
+#include "LockFreeQueue.h"
 
 class NoteDelayer : public NoteEffectBase, public IDrawableModule, public IFloatSliderListener, public IAudioPoller
 {
@@ -72,19 +74,24 @@ private:
    void GetModuleDimensions(float& width, float& height) override
    {
       width = 108;
-      height = 22;
+      height = GetNumDroppedNotes() > 0 ? 40 : 22;
    }
    bool Enabled() const override { return mEnabled; }
+   int GetNumDroppedNotes() const { return mNumDroppedIncomingNotes + mInputNotes.GetNumDropped(); }
 
    float mDelay{ .25 };
    FloatSlider* mDelaySlider{ nullptr };
 
    float mLastNoteOnTime{ 0 };
 
-   static const int kQueueSize = 500;
-   NoteInfo mInputNotes[kQueueSize];
-   int mConsumeIndex{ 0 };
-   int mAppendIndex{ 0 };
+   //PlayNote() can come in from the ui, midi and audio threads, so notes land in mIncomingNotes first,
+   //and the audio thread moves them into mInputNotes, which only it touches
+   LockFreeRingQueue<NoteInfo, 1024> mIncomingNotes;
+   ofMutex mIncomingNotesWriteMutex; //only the writers lock this
+   std::atomic<int> mNumDroppedIncomingNotes{ 0 };
+   std::atomic<bool> mWantClear{ false };
+   TimedEventQueue<NoteInfo> mInputNotes{ 2048 };
+   std::vector<NoteInputElement> mDueNotes;
 };
 
 #endif /* defined(__Bespoke__NoteDelayer__) */
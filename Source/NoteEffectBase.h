@@ -40,6 +40,12 @@ public:
    {
       SendCCOutput(control, value, voiceIdx);
    }
+
+protected:
+   //for effects that transform a block in PlayNoteBlock(). it's still being played while the block runs downstream,
+   //so if a feedback loop brings a block back in (mInNoteOutput), take that one note by note instead
+   std::vector<NoteInputElement> mOutputBlock;
+   static const int kOutputBlockReserve = 256;
 };
 
 #endif
@@ -30,6 +30,7 @@ NoteFilter::NoteFilter()
 : mMinPitch(0)
 , mMaxPitch(7)
 {
+   mOutputBlock.reserve(kOutputBlockReserve);
    for (int i = 0; i < 128; ++i)
    {
       mGate[i] = true;
@@ -81,6 +82,29 @@ void NoteFilter::PlayNote(double time, int pitch, int velocity, int voiceIdx, Mo
    }
 }
 
+void NoteFilter::PlayNoteBlock(const std::vector<NoteInputElement>& notes)
+{
+   if (!mEnabled)
+   {
+      PlayNoteOutputBlock(notes);
+      return;
+   }
+   if (mInNoteOutput)
+   {
+      INoteReceiver::PlayNoteBlock(notes);
+      return;
+   }
+
+   mOutputBlock.clear();
+   for (const NoteInputElement& note : notes)
+   {
+      mLastPlayTime[note.pitch] = note.time;
+      if ((note.pitch >= mMinPitch && note.pitch <= mMaxPitch && mGate[note.pitch]) || note.velocity == 0)
+         mOutputBlock.push_back(note);
+   }
+   PlayNoteOutputBlock(mOutputBlock);
+}
+
 void NoteFilter::GetModuleDimensions(float& width, float& height)
 {
    width = 80;
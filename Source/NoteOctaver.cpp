@@ -32,6 +32,7 @@ NoteOctaver::NoteOctaver()
 : mOctave(0)
 , mOctaveSlider(nullptr)
 {
+   mOutputBlock.reserve(kOutputBlockReserve);
 }
 
 void NoteOctaver::CreateUIControls()
@@ -63,6 +64,40 @@ void NoteOctaver::PlayNote(double time, int pitch, int velocity, int voiceIdx, M
       return;
    }
 
+   UpdateInputNote(pitch, velocity, voiceIdx);
+
+   PlayNoteOutput(time, pitch + mOctave * 12, velocity, voiceIdx, modulation);
+}
+
+void NoteOctaver::PlayNoteBlock(const std::vector<NoteInputElement>& notes)
+{
+   if (!mEnabled)
+   {
+      PlayNoteOutputBlock(notes);
+      return;
+   }
+   if (mInNoteOutput)
+   {
+      INoteReceiver::PlayNoteBlock(notes);
+      return;
+   }
+
+   mOutputBlock.clear();
+   for (const NoteInputElement& note : notes)
+   {
+      UpdateInputNote(note.pitch, note.velocity, note.voiceIdx);
+      int outPitch = note.pitch + mOctave * 12;
+      if (outPitch >= 0 && outPitch < 128)
+      {
+         mOutputBlock.push_back(note);
+         mOutputBlock.back().pitch = outPitch;
+      }
+   }
+   PlayNoteOutputBlock(mOutputBlock);
+}
+
+void NoteOctaver::UpdateInputNote(int pitch, int velocity, int voiceIdx)
+{
    if (pitch >= 0 && pitch < 128)
    {
       if (velocity > 0)
@@ -76,8 +111,6 @@ void NoteOctaver::PlayNote(double time, int pitch, int velocity, int voiceIdx, M
          mInputNotes[pitch].mOn = false;
       }
    }
-
-   PlayNoteOutput(time, pitch + mOctave * 12, velocity, voiceIdx, modulation);
 }
 
 void NoteOctaver::IntSliderUpdated(IntSlider* slider, int oldVal)
@@ -46,6 +46,7 @@ public:
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
+   void PlayNoteBlock(const std::vector<NoteInputElement>& notes) override;
 
    void CheckboxUpdated(Checkbox* checkbox) override;
    //IIntSliderListener
@@ -70,6 +71,7 @@ private:
 
    //IDrawableModule
    void DrawModule() override;
+   bool CanCacheDrawing() const override { return true; }
    void GetModuleDimensions(float& width, float& height) override
    {
       width = 108;
@@ -77,6 +79,8 @@ private:
    }
    bool Enabled() const override { return mEnabled; }
 
+   void UpdateInputNote(int pitch, int velocity, int voiceIdx);
+
    int mOctave;
    IntSlider* mOctaveSlider;
    std::array<NoteInfo, 128> mInputNotes;
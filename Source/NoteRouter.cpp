@@ -76,6 +76,18 @@ void NoteRouter::PlayNote(double time, int pitch, int velocity, int voiceIdx, Mo
    }
 }
 
+void NoteRouter::PlayNoteBlock(const std::vector<NoteInputElement>& notes)
+{
+   for (int i = 0; i < (int)mDestinationCables.size(); ++i)
+   {
+      if ((mRadioButtonMode && mRouteMask == i) ||
+          (!mRadioButtonMode && (mRouteMask & (1 << i))))
+      {
+         mDestinationCables[i]->PlayNoteOutputBlock(notes);
+      }
+   }
+}
+
 void NoteRouter::RadioButtonUpdated(RadioButton* radio, int oldVal)
 {
    if (radio == mRouteSelector)
@@ -48,6 +48,7 @@ public:
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
+   void PlayNoteBlock(const std::vector<NoteInputElement>& notes) override;
 
    //IRadioButtonListener
    void RadioButtonUpdated(RadioButton* radio, int oldVal) override;
@@ -75,6 +75,7 @@ NoteStepSequencer::NoteStepSequencer()
 , mGridControlOffsetX(0)
 , mGridControlOffsetY(0)
 {
+   SetPollRate(kMaxPollRate);
 
    for (int i = 0; i < NSS_MAX_STEPS; ++i)
    {
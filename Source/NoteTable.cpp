@@ -53,6 +53,7 @@ NoteTable::NoteTable()
 , mGridControlOffsetX(0)
 , mGridControlOffsetY(0)
 {
+   SetPollRate(kMaxPollRate);
    for (int i = 0; i < mLength; ++i)
       mTones[i] = i;
 
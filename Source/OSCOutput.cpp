@@ -32,6 +32,7 @@
 
 OSCOutput::OSCOutput()
 {
+   SetPollRate(kMaxPollRate);
    for (int i = 0; i < OSC_OUTPUT_MAX_PARAMS; ++i)
    {
       mParams[i] = 0;
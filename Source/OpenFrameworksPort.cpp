@@ -347,6 +347,61 @@ void ofVertex(float x, float y, float z)
    gShapePoints.push_back(ofVec2f(x, y));
 }
 
+//ofAddLine() calls between these become subpaths of one path, stroked once, instead of a path and stroke per ofLine()
+void ofBeginLines()
+{
+   nvgBeginPath(gNanoVG);
+}
+
+void ofAddLine(float x1, float y1, float x2, float y2)
+{
+   nvgMoveTo(gNanoVG, x1, y1);
+   nvgLineTo(gNanoVG, x2, y2);
+}
+
+void ofEndLines()
+{
+   nvgStroke(gNanoVG);
+}
+
+void ofPolyline(const ofVec2f* points, int numPoints, bool close /*= false*/)
+{
+   if (numPoints < 2)
+      return;
+
+   //skip points that land on top of the last one, they only add tessellation work
+   const float kMinSpacingSq = .5f * .5f;
+   nvgBeginPath(gNanoVG);
+   nvgMoveTo(gNanoVG, points[0].x, points[0].y);
+   ofVec2f last = points[0];
+   for (int i = 1; i < numPoints; ++i)
+   {
+      if (i < numPoints - 1 && ofDistSquared(points[i].x, points[i].y, last.x, last.y) < kMinSpacingSq)
+         continue;
+      nvgLineTo(gNanoVG, points[i].x, points[i].y);
+      last = points[i];
+   }
+   if (close)
+      nvgClosePath(gNanoVG);
+   nvgStroke(gNanoVG);
+}
+
+//fills the band between the top and bottom edges, as one polygon
+void ofFilledEnvelope(const float* x, const float* top, const float* bottom, int numPoints)
+{
+   if (numPoints < 2)
+      return;
+
+   nvgBeginPath(gNanoVG);
+   nvgMoveTo(gNanoVG, x[0], top[0]);
+   for (int i = 1; i < numPoints; ++i)
+      nvgLineTo(gNanoVG, x[i], top[i]);
+   for (int i = numPoints - 1; i >= 0; --i)
+      nvgLineTo(gNanoVG, x[i], bottom[i]);
+   nvgClosePath(gNanoVG);
+   nvgFill(gNanoVG);
+}
+
 float ofMap(float val, float fromStart, float fromEnd, float toStart, float toEnd, bool clamp)
 {
    float ret;
@@ -281,6 +281,11 @@ void ofSetLineWidth(float width);
 void ofBeginShape();
 void ofEndShape(bool close = false);
 void ofVertex(float x, float y, float z = 0);
+void ofBeginLines();
+void ofAddLine(float x1, float y1, float x2, float y2);
+void ofEndLines();
+void ofPolyline(const ofVec2f* points, int numPoints, bool close = false);
+void ofFilledEnvelope(const float* x, const float* top, const float* bottom, int numPoints);
 float ofMap(float val, float fromStart, float fromEnd, float toStart, float toEnd, bool clamp = false);
 float ofRandom(float max);
 float ofRandom(float x, float y);
@@ -96,22 +96,42 @@ void OscController::SendValue(int page, int control, float value, bool forceNote
    {
       if (control == mOscMap[i].mControl) // && mOscMap[i].mLastChangedTime + 50 < gTime)
       {
-         juce::OSCMessage msg(mOscMap[i].mAddress.c_str());
-
          if (mOscMap[i].mIsFloat)
-         {
             mOscMap[i].mFloatValue = value;
-            msg.addFloat32(mOscMap[i].mFloatValue);
-         }
          else
-         {
             mOscMap[i].mIntValue = value * 127;
-            msg.addInt32(mOscMap[i].mIntValue);
-         }
+         mOscMap[i].mNeedsSend = true; //sent in Poll(), so repeated updates to an address only send the latest value
+      }
+   }
+}
 
-         if (mOutputConnected)
-            mOscOut.send(msg);
+void OscController::Poll()
+{
+   if (!mConnected || !mOutputConnected)
+      return;
+
+   mOutputBudget.Refill();
+
+   //pick up where we left off, so a busy address can't starve the ones after it
+   for (int count = 0; count < (int)mOscMap.size(); ++count)
+   {
+      int i = (mNextSendIndex + count) % mOscMap.size();
+      if (!mOscMap[i].mNeedsSend)
+         continue;
+
+      if (!mOutputBudget.TrySpend(1))
+      {
+         mNextSendIndex = i;
+         return;
       }
+
+      juce::OSCMessage msg(mOscMap[i].mAddress.c_str());
+      if (mOscMap[i].mIsFloat)
+         msg.addFloat32(mOscMap[i].mFloatValue);
+      else
+         msg.addInt32(mOscMap[i].mIntValue);
+      mOscOut.send(msg);
+      mOscMap[i].mNeedsSend = false;
    }
 }
 
@@ -140,6 +160,7 @@ void OscController::oscMessageReceived(const juce::OSCMessage& msg)
    {
       MidiNote note;
       note.mDeviceName = "osccontroller";
+      note.mTimestampMs = juce::Time::getMillisecondCounterHiRes();
       note.mChannel = 1;
       int offset = 0;
       if (msg.size() >= 3 && msg[0].isInt32())
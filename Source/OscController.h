@@ -41,6 +41,7 @@ struct OscMap
    float mFloatValue{ 0 };
    int mIntValue{ 0 };
    double mLastChangedTime{ -9999 }; //@TODO(Noxy): Unused but is in savestates.
+   bool mNeedsSend{ false };
 };
 
 class OscController : public INonstandardController,
@@ -54,6 +55,8 @@ public:
    void Connect();
    void oscMessageReceived(const juce::OSCMessage& msg) override;
    void SendValue(int page, int control, float value, bool forceNoteOn = false, int channel = -1) override;
+   void Poll() override;
+   void SetFeedbackRate(float messagesPerMs) { mOutputBudget.SetRate(messagesPerMs); }
    int AddControl(std::string address, bool isFloat);
 
    bool IsInputConnected() override { return mConnected; }
@@ -82,6 +85,8 @@ private:
    bool mOutputConnected;
 
    std::vector<OscMap> mOscMap;
+   OutputBudget mOutputBudget;
+   int mNextSendIndex{ 0 };
 };
 
 #endif /* defined(__Bespoke__OscController__) */
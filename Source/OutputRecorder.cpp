@@ -0,0 +1,220 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    OutputRecorder.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "OutputRecorder.h"
+#include "SynthGlobals.h"
+
+#include <algorithm>
+
+#include "juce_audio_formats/juce_audio_formats.h"
+
+namespace
+{
+   const int kRingLengthSeconds = 2;
+   const int kSpillIntervalMs = 20;
+   const int kExportChunkSize = 16384;
+}
+
+OutputRecorder::OutputRecorder(long long maxLengthSamples, int numChannels)
+: juce::Thread("OutputRecorder")
+, mNumChannels(numChannels)
+, mMaxLength(maxLengthSamples)
+, mFifo(int(gSampleRate * kRingLengthSeconds))
+{
+   mRing.resize(mFifo.getTotalSize() * mNumChannels);
+   OpenSpillFile();
+   startThread();
+}
+
+OutputRecorder::~OutputRecorder()
+{
+   stopThread(1000);
+   mSpillStream.reset();
+   mSpillFile.deleteFile();
+}
+
+//starts a fresh scratch file, and resets the recording to empty. call with mSpillMutex held, or before the spill thread starts
+void OutputRecorder::OpenSpillFile()
+{
+   mSpillFile = juce::File::getSpecialLocation(juce::File::tempDirectory).getNonexistentChildFile("bespoke_output", ".raw", false);
+   mSpillStream = std::make_unique<juce::FileOutputStream>(mSpillFile);
+   if (!mSpillStream->openedOk())
+   {
+      ofLog() << "couldn't create output record file " << mSpillFile.getFullPathName().toStdString();
+      mSpillStream.reset();
+   }
+   mSpilledLength = 0;
+}
+
+void OutputRecorder::Write(const float* const* data, int numChannels, int bufferSize)
+{
+   //if the spill thread fell behind, the frames we lost are owed as silence before anything new goes in, so the recording stays in time
+   int silence = (int)std::min<long long>(mPendingSilence, mFifo.getFreeSpace());
+   int start1, size1, start2, size2;
+   if (silence > 0)
+   {
+      mFifo.prepareToWrite(silence, start1, size1, start2, size2);
+      std::fill(mRing.begin() + start1 * mNumChannels, mRing.begin() + (start1 + size1) * mNumChannels, 0.0f);
+      std::fill(mRing.begin() + start2 * mNumChannels, mRing.begin() + (start2 + size2) * mNumChannels, 0.0f);
+      mFifo.finishedWrite(size1 + size2);
+      mPendingSilence -= size1 + size2;
+   }
+
+   if (mPendingSilence > 0)
+   {
+      mPendingSilence += bufferSize;
+      mNumDroppedSamples += bufferSize;
+      return;
+   }
+
+   mFifo.prepareToWrite(bufferSize, start1, size1, start2, size2);
+
+   for (int i = 0; i < size1 + size2; ++i)
+   {
+      float* frame = &mRing[(i < size1 ? start1 + i : start2 + i - size1) * mNumChannels];
+      for (int ch = 0; ch < mNumChannels; ++ch)
+         frame[ch] = ch < numChannels ? data[ch][i] : 0;
+   }
+
+   mFifo.finishedWrite(size1 + size2);
+
+   if (size1 + size2 < bufferSize)
+   {
+      mPendingSilence += bufferSize - (size1 + size2);
+      mNumDroppedSamples += bufferSize - (size1 + size2);
+   }
+}
+
+void OutputRecorder::run()
+{
+   while (!threadShouldExit())
+   {
+      {
+         std::lock_guard<std::mutex> lock(mSpillMutex);
+         Spill();
+      }
+      wait(kSpillIntervalMs);
+   }
+}
+
+//moves everything in the ring into the scratch file. call with mSpillMutex held
+void OutputRecorder::Spill()
+{
+   int start1, size1, start2, size2;
+   mFifo.prepareToRead(mFifo.getNumReady(), start1, size1, start2, size2);
+
+   if (mSpillStream != nullptr)
+   {
+      const int frameBytes = mNumChannels * sizeof(float);
+      for (int run = 0; run < 2; ++run)
+      {
+         int ringPos = run == 0 ? start1 : start2;
+         int numFrames = run == 0 ? size1 : size2;
+         while (numFrames > 0)
+         {
+            long long filePos = mSpilledLength % mMaxLength;
+            int length = (int)std::min<long long>(numFrames, mMaxLength - filePos);
+            mSpillStream->setPosition(filePos * frameBytes);
+            mSpillStream->write(&mRing[ringPos * mNumChannels], length * frameBytes);
+            mSpilledLength += length;
+            ringPos += length;
+            numFrames -= length;
+         }
+      }
+      mSpillStream->flush();
+   }
+
+   mFifo.finishedRead(size1 + size2);
+}
+
+bool OutputRecorder::SaveRecording(const std::string& path)
+{
+   //hand the current scratch file over to the export, and start the next recording in a new one.
+   //the spill thread never touches the old file again, so we can read it at our own pace and delete it after
+   juce::File recordedFile;
+   long long start, end;
+   {
+      std::lock_guard<std::mutex> lock(mSpillMutex);
+      Spill();
+      end = mSpilledLength;
+      start = std::max(0LL, end - mMaxLength);
+      recordedFile = mSpillFile;
+      OpenSpillFile();
+   }
+
+   int numDropped = mNumDroppedSamples.exchange(0);
+   if (numDropped > 0)
+      ofLog() << "output recording fell behind, " << numDropped << " samples were replaced with silence";
+
+   bool saved = ExportRange(recordedFile, start, end, path);
+   recordedFile.deleteFile();
+   return saved;
+}
+
+bool OutputRecorder::ExportRange(const juce::File& file, long long start, long long end, const std::string& path)
+{
+   juce::FileInputStream input(file);
+   if (!input.openedOk())
+      return false;
+
+   auto wavFormat = std::make_unique<juce::WavAudioFormat>();
+   juce::File outputFile(ofToDataPath(path));
+   outputFile.create();
+   auto outputTo = outputFile.createOutputStream();
+   if (outputTo == nullptr)
+      return false;
+   bool b1{ false };
+   auto writer = std::unique_ptr<juce::AudioFormatWriter>(
+   wavFormat->createWriterFor(outputTo.release(), gSampleRate, mNumChannels, 16, b1, 0));
+
+   //stream the file across in chunks
+   const int frameBytes = mNumChannels * sizeof(float);
+   std::vector<float> interleaved(kExportChunkSize * mNumChannels);
+   std::vector<float> channelData(kExportChunkSize * mNumChannels);
+   std::vector<float*> channels(mNumChannels);
+   for (int ch = 0; ch < mNumChannels; ++ch)
+      channels[ch] = &channelData[ch * kExportChunkSize];
+
+   for (long long frame = start; frame < end;)
+   {
+      long long filePos = frame % mMaxLength;
+      int length = (int)std::min({ (long long)kExportChunkSize, end - frame, mMaxLength - filePos });
+      input.setPosition(filePos * frameBytes);
+      if (input.read(interleaved.data(), length * frameBytes) != length * frameBytes)
+         break;
+
+      for (int i = 0; i < length; ++i)
+      {
+         for (int ch = 0; ch < mNumChannels; ++ch)
+            channels[ch][i] = interleaved[i * mNumChannels + ch];
+      }
+      writer->writeFromFloatArrays(channels.data(), mNumChannels, length);
+      frame += length;
+   }
+
+   return true;
+}
@@ -0,0 +1,67 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    OutputRecorder.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "juce_core/juce_core.h"
+
+//keeps the last N minutes of the main output. the audio thread only writes into a small ring,
+//and a background thread spills the ring into a circular scratch file on disk
+class OutputRecorder : public juce::Thread
+{
+public:
+   OutputRecorder(long long maxLengthSamples, int numChannels);
+   ~OutputRecorder();
+
+   void Write(const float* const* data, int numChannels, int bufferSize); //audio thread
+   bool SaveRecording(const std::string& path); //exports the recorded range to a wav, and starts a new recording
+
+private:
+   //juce::Thread
+   void run() override;
+
+   void Spill();
+   void OpenSpillFile();
+   bool ExportRange(const juce::File& file, long long start, long long end, const std::string& path);
+
+   int mNumChannels;
+   long long mMaxLength;
+   juce::AbstractFifo mFifo;
+   std::vector<float> mRing; //interleaved
+   juce::File mSpillFile;
+   std::unique_ptr<juce::FileOutputStream> mSpillStream;
+   std::mutex mSpillMutex;
+   std::atomic<long long> mSpilledLength{ 0 };
+   long long mPendingSilence{ 0 }; //audio thread only. frames that didn't fit in the ring, written as silence once there's room
+   std::atomic<int> mNumDroppedSamples{ 0 };
+};
@@ -30,6 +30,7 @@
 
 PSMoveController::PSMoveController()
 {
+   SetPollRate(kMaxPollRate);
    mMoveMgr.Setup();
 
    mVibration.SetValue(0);
@@ -77,6 +77,8 @@ void PatchCable::Render()
    ofVec2f cableFadeOut = cable.start * .47 + cable.end * .53f;
    ofVec2f cableFadeIn = cable.start * .53f + cable.end * .47f;
    float cableQuality = gDrawScale * UserPrefs.cable_quality.Get();
+   ofRectangle cableRect(MIN(cable.start.x, cable.end.x), MIN(cable.start.y, cable.end.y), fabsf(cable.end.x - cable.start.x), fabsf(cable.end.y - cable.start.y));
+   bool onScreen = cableRect.intersects(TheSynth->GetDrawRect());
 
    float lineWidth = 1;
    float plugWidth = 4;
@@ -110,10 +112,12 @@ void PatchCable::Render()
          IAudioSource* audioSource = dynamic_cast<IAudioSource*>(GetOwningModule());
          if (audioSource)
          {
-            RollingBuffer* vizBuff = mOwner->GetOverrideVizBuffer();
+            VizBuffer* vizBuff = mOwner->GetOverrideVizBuffer();
             if (vizBuff == nullptr)
                vizBuff = audioSource->GetVizBuffer();
             assert(vizBuff);
+            if (onScreen)
+               vizBuff->Watch();
             int numSamples = vizBuff->Size();
             bool allZero = true;
             for (int ch = 0; ch < vizBuff->NumChannels(); ++ch)
@@ -342,10 +346,12 @@ void PatchCable::Render()
       {
          ofSetLineWidth(lineWidth);
 
-         RollingBuffer* vizBuff = mOwner->GetOverrideVizBuffer();
+         VizBuffer* vizBuff = mOwner->GetOverrideVizBuffer();
          if (vizBuff == nullptr)
             vizBuff = audioSource->GetVizBuffer();
          assert(vizBuff);
+         if (onScreen)
+            vizBuff->Watch();
          int numSamples = vizBuff->Size();
          float dx = (cable.plug.x - cable.start.x) / wireLength;
          float dy = (cable.plug.y - cable.start.y) / wireLength;
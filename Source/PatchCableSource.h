@@ -35,6 +35,7 @@ class IAudioReceiver;
 class INoteReceiver;
 class IPulseReceiver;
 class IModulator;
+class VizBuffer;
 
 enum DefaultPatchBehavior
 {
@@ -95,8 +96,8 @@ public:
    ConnectionType GetConnectionType() const { return mType; }
    void SetConnectionType(ConnectionType type);
    IDrawableModule* GetOwner() const { return mOwner; }
-   void SetOverrideVizBuffer(RollingBuffer* viz) { mOverrideVizBuffer = viz; }
-   RollingBuffer* GetOverrideVizBuffer() const { return mOverrideVizBuffer; }
+   void SetOverrideVizBuffer(VizBuffer* viz) { mOverrideVizBuffer = viz; }
+   VizBuffer* GetOverrideVizBuffer() const { return mOverrideVizBuffer; }
    void UpdatePosition(bool parentMinimized);
    void SetManualPosition(int x, int y)
    {
@@ -177,7 +178,7 @@ private:
    DefaultPatchBehavior mDefaultPatchBehavior;
    PatchCableDrawMode mPatchCableDrawMode;
    IDrawableModule* mOwner;
-   RollingBuffer* mOverrideVizBuffer;
+   VizBuffer* mOverrideVizBuffer;
    bool mAutomaticPositioning;
    int mManualPositionX;
    int mManualPositionY;
@@ -31,9 +31,9 @@ void PeakTracker::Process(float* buffer, int bufferSize)
 {
    PROFILER(PeakTracker);
 
+   float scalar = powf(0.5f, 1.0f / (mDecayTime * gSampleRate));
    for (int j = 0; j < bufferSize; ++j)
    {
-      float scalar = powf(0.5f, 1.0f / (mDecayTime * gSampleRate));
       float input = fabsf(buffer[j]);
 
       if (input >= mPeak)
@@ -83,6 +83,7 @@ private:
    };
 
    float* mOutputBuffer;
+   float* mRampBuffer;
    PitchShifterVoice mShifters[kNumShifters];
    bool mPassthrough;
    Checkbox* mPassthroughCheckbox;
@@ -38,6 +38,7 @@ IDrawableModule* Prefab::sJustReleasedModule = nullptr;
 
 Prefab::Prefab()
 {
+   SetPollRate(kMaxPollRate);
    mModuleContainer.SetOwner(this);
    mPrefabName = "";
 }
@@ -33,6 +33,7 @@ std::vector<IUIControl*> Presets::sPresetHighlightControls;
 
 Presets::Presets()
 {
+   SetPollRate(kMaxPollRate);
 }
 
 Presets::~Presets()
@@ -108,6 +108,7 @@ Push2Control::Push2Control()
 , mSpawnLists(this)
 , mSelectedGridSpawnListIndex(-1)
 {
+   SetPollRate(kMaxPollRate);
    Initialize();
    for (int i = 0; i < 128 * 2; ++i)
       mLedState[i] = -1;
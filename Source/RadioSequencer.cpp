@@ -38,6 +38,7 @@ namespace
 
 RadioSequencer::RadioSequencer()
 {
+   SetPollRate(kMaxPollRate);
 }
 
 void RadioSequencer::Init()
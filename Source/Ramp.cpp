@@ -26,6 +26,8 @@
 #include "Ramp.h"
 #include "SynthGlobals.h"
 
+#include <limits>
+
 void Ramp::Start(double curTime, float end, double endTime)
 {
    float startValue = Value(curTime);
@@ -74,6 +76,55 @@ float Ramp::Value(double time) const
    return retVal;
 }
 
+void Ramp::FillBuffer(double time, float* buffer, int bufferSize) const
+{
+   //callers usually Start() a ramp at the time of the buffer they're filling, and a ramp only takes over
+   //after its start time, so fill one segment at a time rather than expecting one segment to cover the buffer
+   for (int i = 0; i < bufferSize;)
+   {
+      double sampleTime = time + i * gInvSampleRateMs;
+      const RampData* rampData = GetCurrentRampData(sampleTime);
+
+      double nextStartTime = std::numeric_limits<double>::max();
+      for (const auto& other : mRampDatas)
+      {
+         if (other.mStartTime >= sampleTime && other.mStartTime < nextStartTime)
+            nextStartTime = other.mStartTime;
+      }
+      int segmentEnd = i + 1;
+      while (segmentEnd < bufferSize && time + segmentEnd * gInvSampleRateMs <= nextStartTime)
+         ++segmentEnd;
+
+      if (rampData->mStartTime == -1 || rampData->mEndTime <= rampData->mStartTime)
+      {
+         for (; i < segmentEnd; ++i)
+            buffer[i] = Value(time + i * gInvSampleRateMs);
+         continue;
+      }
+
+      //within a segment the ramp is linear in time, so step the blend instead of looking it up for every sample
+      double blend = (sampleTime - rampData->mStartTime) / (rampData->mEndTime - rampData->mStartTime);
+      double blendStep = gInvSampleRateMs / (rampData->mEndTime - rampData->mStartTime);
+      for (; i < segmentEnd; ++i)
+      {
+         if (blend <= 0)
+         {
+            buffer[i] = rampData->mStartValue;
+         }
+         else if (blend >= 1)
+         {
+            buffer[i] = rampData->mEndValue;
+         }
+         else
+         {
+            float value = rampData->mStartValue + blend * (rampData->mEndValue - rampData->mStartValue);
+            buffer[i] = (fabsf(value) < FLT_EPSILON) ? 0 : value;
+         }
+         blend += blendStep;
+      }
+   }
+}
+
 const Ramp::RampData* Ramp::GetCurrentRampData(double time) const
 {
    int ret = 0;
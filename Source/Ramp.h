@@ -40,6 +40,7 @@ public:
    void SetValue(float val);
    bool HasValue(double time) const;
    float Value(double time) const;
+   void FillBuffer(double time, float* buffer, int bufferSize) const;
    float Target(double time) const { return GetCurrentRampData(time)->mEndValue; }
 
 private:
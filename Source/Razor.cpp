@@ -150,7 +150,7 @@ void Razor::Process(double time)
 
    for (int i = 0; i < bufferSize; ++i)
    {
-      float freq = TheScale->PitchToFreq(mPitch + (mPitchBend ? mPitchBend->GetValue(i) : 0));
+      float freq = TheScale->PitchToFreq(mPitch + (mPitchBend ? mPitchBend->GetBlockValue(i) : 0));
 
       int oscNyquistLimitIdx = int(gNyquistLimit / freq);
 
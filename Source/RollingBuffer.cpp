@@ -64,12 +64,74 @@ void RollingBuffer::ReadChunk(float* dst, int size, int samplesAgo, int channel)
    }
 }
 
+void RollingBuffer::ReadChunkDelayed(float* dst, int size, float delaySamps, int channel)
+{
+   assert(delaySamps >= size);
+   assert(delaySamps < Size() - 1);
+
+   int sampsAgo = int(delaySamps);
+   float a = delaySamps - sampsAgo;
+   const float* buffer = mBuffer.GetChannel(channel);
+
+   //a fixed delay reads forward through the buffer, so this is at most two contiguous runs
+   int pos = mOffsetToNow[channel] - sampsAgo;
+   if (pos < 0)
+      pos += Size();
+   float prev = buffer[pos > 0 ? pos - 1 : Size() - 1];
+   for (int i = 0; i < size;)
+   {
+      int run = MIN(size - i, Size() - pos);
+      const float* src = buffer + pos;
+      dst[i] = (1 - a) * src[0] + a * prev; //interpolate
+      for (int j = 1; j < run; ++j)
+         dst[i + j] = (1 - a) * src[j] + a * src[j - 1];
+      prev = src[run - 1];
+      i += run;
+      pos = 0;
+   }
+}
+
+void RollingBuffer::ReadChunkDelayed(float* dst, int size, const float* delaySamps, int channel)
+{
+   const float* buffer = mBuffer.GetChannel(channel);
+   const int bufferSize = Size();
+   const int now = mOffsetToNow[channel];
+
+   //no modulo and no branches on the data, so that the interpolation can be vectorized
+   for (int i = 0; i < size; ++i)
+   {
+      assert(delaySamps[i] >= i + 1);
+      assert(delaySamps[i] < bufferSize - 1);
+
+      int sampsAgo = int(delaySamps[i]);
+      float a = delaySamps[i] - sampsAgo;
+      int posA = now + i - sampsAgo;
+      posA += (posA < 0) ? bufferSize : 0;
+      int posB = posA - 1;
+      posB += (posB < 0) ? bufferSize : 0;
+      dst[i] = (1 - a) * buffer[posA] + a * buffer[posB]; //interpolate
+   }
+}
+
 void RollingBuffer::Accum(int samplesAgo, float sample, int channel)
 {
    assert(samplesAgo < Size());
    mBuffer.GetChannel(channel)[(Size() + mOffsetToNow[channel] - samplesAgo) % Size()] += sample;
 }
 
+void RollingBuffer::AccumChunk(const float* samples, int size, int samplesAgo, int channel)
+{
+   assert(size + samplesAgo <= Size());
+
+   int offset = mOffsetToNow[channel] - samplesAgo - size;
+   if (offset < 0)
+      offset += Size();
+
+   int run = MIN(size, Size() - offset);
+   Add(mBuffer.GetChannel(channel) + offset, samples, run);
+   Add(mBuffer.GetChannel(channel), samples + run, size - run);
+}
+
 void RollingBuffer::WriteChunk(float* samples, int size, int channel)
 {
    assert(size < Size());
@@ -37,6 +37,10 @@ public:
    ~RollingBuffer();
    float GetSample(int samplesAgo, int channel);
    void ReadChunk(float* dst, int size, int samplesAgo, int channel);
+   //interpolated reads for the block that is about to be written, where sample i is delayed by delaySamps (or delaySamps[i]) relative to its own position in the block
+   //every delay must be at least size samples, so that nothing is read from the block itself
+   void ReadChunkDelayed(float* dst, int size, float delaySamps, int channel);
+   void ReadChunkDelayed(float* dst, int size, const float* delaySamps, int channel);
    void WriteChunk(float* samples, int size, int channel);
    void Write(float sample, int channel);
    void ClearBuffer();
@@ -45,6 +49,7 @@ public:
    ChannelBuffer* GetRawBuffer() { return &mBuffer; }
    int GetRawBufferOffset(int channel) { return mOffsetToNow[channel]; }
    void Accum(int samplesAgo, float sample, int channel);
+   void AccumChunk(const float* samples, int size, int samplesAgo, int channel);
    void SetNumChannels(int channels) { mBuffer.SetNumActiveChannels(channels); }
    int NumChannels() const { return mBuffer.NumActiveChannels(); }
 
@@ -28,18 +28,30 @@
 #include "FileStream.h"
 #include "ModularSynth.h"
 #include "ChannelBuffer.h"
+#include "SampleStream.h"
+#include "SampleCache.h"
+#include "SampleDecoder.h"
+#include "SincResampler.h"
+#include "UserPrefs.h"
 #include <memory>
 
 #include "juce_audio_formats/juce_audio_formats.h"
 
+namespace
+{
+   const float kStreamHeadSeconds = 2;
+}
+
 Sample::Sample()
-: mData(0)
+: mData(std::make_shared<ChannelBuffer>(0))
 {
    mName[0] = 0;
 }
 
 Sample::~Sample()
 {
+   CancelLoad();
+   delete mReader;
 }
 
 bool Sample::Read(const char* path, bool mono, ReadType readType)
@@ -49,35 +61,110 @@ bool Sample::Read(const char* path, bool mono, ReadType readType)
    std::vector<std::string> tokens = ofSplitString(mReadPath, "/");
    mName = tokens[tokens.size() - 1];
 
+   if (mStream)
+   {
+      LockDataMutex(true);
+      mStream.reset();
+      LockDataMutex(false);
+   }
+
+   CancelLoad();
+
    juce::File file(ofToDataPath(mReadPath));
    delete mReader;
+   mReader = nullptr;
+   mReadMono = mono;
+
+   if (readType != ReadType::Stream)
+   {
+      float sampleRate;
+      std::shared_ptr<ChannelBuffer> cached;
+      if (UserPrefs.resample_samples_on_load.Get())
+         cached = SampleCache::Get()->Find(file, mono, sampleRate, gSampleRate);
+      if (cached == nullptr)
+      {
+         cached = SampleCache::Get()->Find(file, mono, sampleRate);
+         if (cached != nullptr && ShouldResampleOnLoad(sampleRate))
+            cached = nullptr; //read it again, so we can convert it
+      }
+      if (cached != nullptr)
+      {
+         SetData(cached);
+         mNumSamples = cached->BufferSize();
+         mOffset = mNumSamples;
+         mSampleRateRatio = sampleRate / gSampleRate;
+         return true;
+      }
+   }
+
    mReader = TheSynth->GetAudioFormatManager().createReaderFor(file);
 
    if (mReader != nullptr)
    {
-      mData.Resize((int)mReader->lengthInSamples);
+      int loadLength = (int)mReader->lengthInSamples;
+      if (readType == ReadType::Stream)
+         loadLength = MIN(loadLength, int(kStreamHeadSeconds * mReader->sampleRate));
+
+      double resampleRatio = 1;
+      if (readType != ReadType::Stream && ShouldResampleOnLoad(mReader->sampleRate))
+         resampleRatio = mReader->sampleRate / gSampleRate;
+      int asyncLength = SincResampler::GetOutputLength(loadLength, resampleRatio); //async reads get converted as they're decoded
+
+      auto data = std::make_shared<ChannelBuffer>(readType == ReadType::Async ? asyncLength : loadLength);
       if (mono)
-         mData.SetNumActiveChannels(1);
+         data->SetNumActiveChannels(1);
       else
-         mData.SetNumActiveChannels(mReader->numChannels);
-      mData.Clear();
+         data->SetNumActiveChannels(mReader->numChannels);
+      SetData(data);
 
       mNumSamples = (int)mReader->lengthInSamples;
       mOffset = mNumSamples;
       mSampleRateRatio = float(mReader->sampleRate) / gSampleRate;
 
-      mReadBuffer = std::make_unique<juce::AudioSampleBuffer>();
-      mReadBuffer->setSize(mReader->numChannels, mNumSamples);
+      if (readType != ReadType::Async)
+      {
+         mReadBuffer = std::make_unique<juce::AudioSampleBuffer>();
+         mReadBuffer->setSize(mReader->numChannels, loadLength);
+      }
 
       if (readType == ReadType::Sync)
       {
          mReader->read(mReadBuffer.get(), 0, mNumSamples, 0, true, true);
          FinishRead();
+         if (resampleRatio != 1)
+         {
+            SetData(SincResampler::Process(mData.get(), mNumSamples, resampleRatio));
+            mNumSamples = mData->BufferSize();
+            mOffset = mNumSamples;
+            mSampleRateRatio = 1;
+            AddToCache(gSampleRate, gSampleRate);
+         }
+         else
+         {
+            AddToCache(mReader->sampleRate);
+         }
+      }
+      else if (readType == ReadType::Stream)
+      {
+         mReader->read(mReadBuffer.get(), 0, loadLength, 0, true, true);
+         FinishRead();
+         mData->EnableWaveformPyramid();
+         if (loadLength < mNumSamples)
+         {
+            mStream = std::make_unique<SampleStream>(mReader, mData.get(), mNumSamples);
+            mReader = nullptr; //the stream owns it now
+         }
       }
       else if (readType == ReadType::Async)
       {
-         mSamplesLeftToRead = mNumSamples;
-         startTimer(100);
+         for (int ch = 0; ch < data->NumActiveChannels(); ++ch)
+            data->GetChannel(ch); //set up buffers here, the decode threads can't
+         mDecodeJob = SampleDecoder::Get()->Decode(mReader, data, resampleRatio);
+         mReader = nullptr; //the decoder owns it now
+         mNumSamples = asyncLength;
+         mOffset = mNumSamples;
+         mSampleRateRatio = mDecodeJob->mSampleRate / gSampleRate;
+         startTimer(30);
       }
 
       return true;
@@ -92,52 +179,100 @@ bool Sample::Read(const char* path, bool mono, ReadType readType)
 
 void Sample::FinishRead()
 {
-   if (mData.NumActiveChannels() == 1 && mReadBuffer->getNumChannels() > 1)
+   if (mData->NumActiveChannels() == 1 && mReadBuffer->getNumChannels() > 1)
    {
-      BufferCopy(mData.GetChannel(0), mReadBuffer->getReadPointer(0), mReadBuffer->getNumSamples()); //put first channel in
+      BufferCopy(mData->GetChannel(0), mReadBuffer->getReadPointer(0), mReadBuffer->getNumSamples()); //put first channel in
       for (int ch = 1; ch < mReadBuffer->getNumChannels(); ++ch)
-         Add(mData.GetChannel(0), mReadBuffer->getReadPointer(ch), mReadBuffer->getNumSamples()); //add the other channels
-      Mult(mData.GetChannel(0), 1.0f / mReadBuffer->getNumChannels(), mReadBuffer->getNumSamples()); //normalize volume
+         Add(mData->GetChannel(0), mReadBuffer->getReadPointer(ch), mReadBuffer->getNumSamples()); //add the other channels
+      Mult(mData->GetChannel(0), 1.0f / mReadBuffer->getNumChannels(), mReadBuffer->getNumSamples()); //normalize volume
    }
    else
    {
       for (int ch = 0; ch < mReadBuffer->getNumChannels(); ++ch)
-         BufferCopy(mData.GetChannel(ch), mReadBuffer->getReadPointer(ch), mReadBuffer->getNumSamples());
+         BufferCopy(mData->GetChannel(ch), mReadBuffer->getReadPointer(ch), mReadBuffer->getNumSamples());
+   }
+}
+
+void Sample::AddToCache(float sampleRate, int resampledRate /*= 0*/)
+{
+   mData->EnableWaveformPyramid(); //the data won't change from here on, so drawing can summarize it
+   SampleCache::Get()->Add(juce::File(ofToDataPath(mReadPath)), mReadMono, mData, sampleRate, resampledRate);
+}
+
+//static
+bool Sample::ShouldResampleOnLoad(float sampleRate)
+{
+   return UserPrefs.resample_samples_on_load.Get() && sampleRate != gSampleRate;
+}
+
+void Sample::SetData(std::shared_ptr<ChannelBuffer> data)
+{
+   LockDataMutex(true);
+   mData = data;
+   LockDataMutex(false);
+}
+
+float Sample::GetSampleLoadProgress() const
+{
+   return mDecodeJob != nullptr ? mDecodeJob->GetProgress() : 1;
+}
+
+int Sample::GetNumDecodedSamples() const
+{
+   if (mDecodeJob != nullptr && !mDecodeJob->IsFinished())
+      return mDecodeJob->mResampledRate != 0 ? 0 : mDecodeJob->mNumDecoded.load(); //resampled data only lands in mData once it's all done
+   return NumLoadedSamples();
+}
+
+//blocks until an async read is done, for when something needs the whole sample right now
+void Sample::FinishLoading()
+{
+   if (mDecodeJob != nullptr)
+   {
+      mDecodeJob->WaitUntilDone();
+      timerCallback();
+   }
+}
+
+void Sample::CancelLoad()
+{
+   if (mDecodeJob != nullptr)
+   {
+      mDecodeJob->Cancel();
+      mDecodeJob.reset();
+      stopTimer();
    }
 }
 
 //juce::Timer
 void Sample::timerCallback()
 {
-   int samplesToRead = 44100 * 10;
-   if (samplesToRead > mSamplesLeftToRead)
-      samplesToRead = mSamplesLeftToRead;
-   int startSample = mNumSamples - mSamplesLeftToRead;
-   mReader->read(mReadBuffer.get(), startSample, samplesToRead, startSample, true, true);
-   mSamplesLeftToRead -= samplesToRead;
-
-   if (mSamplesLeftToRead <= 0)
+   if (mDecodeJob != nullptr && mDecodeJob->IsFinished())
    {
-      FinishRead();
+      AddToCache(mDecodeJob->mSampleRate, mDecodeJob->mResampledRate);
+      mDecodeJob.reset();
       stopTimer();
    }
 }
 
 void Sample::Create(int length)
 {
-   mData.Resize(length);
-   mData.SetNumActiveChannels(1);
+   CancelLoad();
+   SetData(std::make_shared<ChannelBuffer>(length));
+   mData->SetNumActiveChannels(1);
    Setup(length);
 }
 
 void Sample::Create(ChannelBuffer* data)
 {
+   CancelLoad();
    int channels = data->NumActiveChannels();
    int length = data->BufferSize();
-   mData.Resize(length);
-   mData.SetNumActiveChannels(channels);
+   auto newData = std::make_shared<ChannelBuffer>(length);
+   newData->SetNumActiveChannels(channels);
    for (int ch = 0; ch < channels; ++ch)
-      BufferCopy(mData.GetChannel(ch), data->GetChannel(ch), length);
+      BufferCopy(newData->GetChannel(ch), data->GetChannel(ch), length);
+   SetData(newData);
    Setup(length);
 }
 
@@ -154,8 +289,9 @@ void Sample::Setup(int length)
 
 bool Sample::Write(const char* path /*=nullptr*/)
 {
+   FinishLoading();
    const std::string writeTo = path ? path : mReadPath;
-   WriteDataToFile(writeTo, &mData, mNumSamples);
+   WriteDataToFile(writeTo, mData.get(), NumLoadedSamples());
    return true;
 }
 
@@ -219,6 +355,8 @@ bool Sample::ConsumeData(double time, ChannelBuffer* out, int size, bool replace
    }
 
    LockDataMutex(true);
+   if (mStream)
+      mStream->Cue(mOffset);
    for (int i = 0; i < size; ++i)
    {
       if (time < mStartTime)
@@ -233,11 +371,16 @@ bool Sample::ConsumeData(double time, ChannelBuffer* out, int size, bool replace
       {
          for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
          {
-            int dataChannel = MIN(ch, mData.NumActiveChannels() - 1);
+            int dataChannel = MIN(ch, mData->NumActiveChannels() - 1);
 
             float sample = 0;
             if (mOffset < end || mLooping)
-               sample = GetInterpolatedSample(mOffset, mData.GetChannel(dataChannel), mNumSamples) * mVolume;
+            {
+               if (mStream)
+                  sample = mStream->GetInterpolatedSample(mOffset, dataChannel) * mVolume;
+               else
+                  sample = GetInterpolatedSample(mOffset, mData->GetChannel(dataChannel), mNumSamples) * mVolume;
+            }
 
             if (replace)
                out->GetChannel(ch)[i] = sample;
@@ -249,6 +392,8 @@ bool Sample::ConsumeData(double time, ChannelBuffer* out, int size, bool replace
       }
       time += gInvSampleRateMs;
    }
+   if (mStream)
+      mStream->Release(mOffset);
    LockDataMutex(false);
    mPlayMutex.unlock();
 
@@ -300,10 +445,12 @@ void Sample::ShiftWrap(int numSamplesToShift)
 
 void Sample::CopyFrom(Sample* sample)
 {
-   mNumSamples = sample->mNumSamples;
-   if (mData.BufferSize() != sample->mData.BufferSize())
-      mData.Resize(sample->mNumSamples);
-   mData.CopyFrom(&sample->mData);
+   CancelLoad();
+   sample->FinishLoading();
+   mNumSamples = sample->NumLoadedSamples(); //only the in-memory part of a streamed sample
+   auto data = std::make_shared<ChannelBuffer>(mNumSamples);
+   data->CopyFrom(sample->mData.get(), mNumSamples);
+   SetData(data);
    mNumBars = sample->mNumBars;
    mLooping = sample->mLooping;
    mRate = sample->mRate;
@@ -320,11 +467,14 @@ namespace
 
 void Sample::SaveState(FileStreamOut& out)
 {
+   FinishLoading();
+
    out << kSaveStateRev;
 
-   out << mNumSamples;
-   if (mNumSamples > 0)
-      mData.Save(out, mNumSamples);
+   int numSamples = NumLoadedSamples();
+   out << numSamples;
+   if (numSamples > 0)
+      mData->Save(out, numSamples);
    out << mNumBars;
    out << mLooping;
    out << mRate;
@@ -336,6 +486,8 @@ void Sample::SaveState(FileStreamOut& out)
 
 void Sample::LoadState(FileStreamIn& in)
 {
+   CancelLoad();
+
    int rev;
    in >> rev;
 
@@ -343,7 +495,9 @@ void Sample::LoadState(FileStreamIn& in)
    if (mNumSamples > 0)
    {
       int readLength;
-      mData.Load(in, readLength, ChannelBuffer::LoadMode::kSetBufferSize);
+      auto data = std::make_shared<ChannelBuffer>(0);
+      data->Load(in, readLength, ChannelBuffer::LoadMode::kSetBufferSize);
+      SetData(data);
       assert(readLength == mNumSamples);
       /*for (int ch=0; ch<mData.NumActiveChannels(); ++ch)
       {
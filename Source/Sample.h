@@ -29,11 +29,14 @@
 #include "OpenFrameworksPort.h"
 #include "ChannelBuffer.h"
 #include <limits>
+#include <memory>
 
 #include "juce_events/juce_events.h"
 
 class FileStreamOut;
 class FileStreamIn;
+class SampleStream;
+struct SampleDecodeJob;
 
 namespace juce
 {
@@ -49,7 +52,8 @@ public:
    enum class ReadType
    {
       Sync,
-      Async
+      Async, //decode on the SampleDecoder threads. the length is known right away, and the data fills in from the front
+      Stream //keep only the start in memory, and stream the rest from disk as it plays. only ConsumeData() sees past the start
    };
 
    Sample();
@@ -62,8 +66,8 @@ public:
    std::string Name() const { return mName; }
    void SetName(std::string name) { mName = name; }
    int LengthInSamples() const { return mNumSamples; }
-   int NumChannels() const { return mData.NumActiveChannels(); }
-   ChannelBuffer* Data() { return &mData; }
+   int NumChannels() const { return mData->NumActiveChannels(); }
+   ChannelBuffer* Data() { return mData.get(); } //samples read from the same file share this through SampleCache, so don't write into it
    double GetPlayPosition() const { return mOffset; }
    void SetPlayPosition(double sample) { mOffset = sample; }
    float GetSampleRateRatio() const { return mSampleRateRatio; }
@@ -85,19 +89,27 @@ public:
    int GetNumBars() const { return mNumBars; }
    void SetVolume(float vol) { mVolume = vol; }
    void CopyFrom(Sample* sample);
-   bool IsSampleLoading() { return mSamplesLeftToRead > 0; }
-   float GetSampleLoadProgress() { return (mNumSamples > 0) ? (1 - (float(mSamplesLeftToRead) / mNumSamples)) : 1; }
+   bool IsSampleLoading() const { return mDecodeJob != nullptr; }
+   bool IsStreaming() const { return mStream != nullptr; }
+   float GetSampleLoadProgress() const;
+   int GetNumDecodedSamples() const; //how much of Data() holds audio so far. less than LengthInSamples() while loading async, or when streaming
+   void FinishLoading();
+   void CancelLoad();
 
    void SaveState(FileStreamOut& out);
    void LoadState(FileStreamIn& in);
 
 private:
    void Setup(int length);
+   int NumLoadedSamples() const { return MIN(mNumSamples, mData->BufferSize()); }
+   void SetData(std::shared_ptr<ChannelBuffer> data);
+   void AddToCache(float sampleRate, int resampledRate = 0);
+   static bool ShouldResampleOnLoad(float sampleRate);
    void FinishRead();
    //juce::Timer
    void timerCallback();
 
-   ChannelBuffer mData;
+   std::shared_ptr<ChannelBuffer> mData;
    int mNumSamples{ 0 };
    double mStartTime{ 0 };
    double mOffset{ std::numeric_limits<double>::max() };
@@ -114,7 +126,9 @@ private:
 
    juce::AudioFormatReader* mReader{};
    std::unique_ptr<juce::AudioSampleBuffer> mReadBuffer;
-   int mSamplesLeftToRead{ 0 };
+   std::shared_ptr<SampleDecodeJob> mDecodeJob;
+   bool mReadMono{ false };
+   std::unique_ptr<SampleStream> mStream;
 };
 
 #endif /* defined(__modularSynth__Sample__) */
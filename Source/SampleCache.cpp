@@ -0,0 +1,194 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleCache.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "SampleCache.h"
+#include "ChannelBuffer.h"
+#include "FileStream.h"
+#include "SampleDecoder.h"
+#include "SynthGlobals.h"
+#include "UserPrefs.h"
+
+namespace
+{
+   const int kDiskCacheRev = 0;
+   const char* kDiskCacheDir = "internal/resampled";
+}
+
+//static
+SampleCache* SampleCache::Get()
+{
+   static SampleCache sCache;
+   return &sCache;
+}
+
+//static
+std::string SampleCache::GetKey(const juce::File& file, bool mono, int resampledRate)
+{
+   std::string key = file.getFullPathName().toStdString() + "|" + ofToString(file.getLastModificationTime().toMilliseconds()) + (mono ? "|mono" : "");
+   if (resampledRate > 0)
+      key += "|" + ofToString(resampledRate);
+   return key;
+}
+
+//static
+juce::File SampleCache::GetDiskCacheFile(const std::string& key)
+{
+   return juce::File(ofToDataPath(kDiskCacheDir)).getChildFile(juce::String::toHexString(juce::String(key).hashCode64()) + ".bin");
+}
+
+std::shared_ptr<ChannelBuffer> SampleCache::Find(const juce::File& file, bool mono, float& sampleRate, int resampledRate /*= 0*/)
+{
+   std::string key = GetKey(file, mono, resampledRate);
+
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      auto iter = mEntries.find(key);
+      if (iter != mEntries.end())
+      {
+         ++mNumHits;
+         mLru.splice(mLru.begin(), mLru, iter->second.mLruPosition);
+         sampleRate = iter->second.mSampleRate;
+         return iter->second.mData;
+      }
+   }
+
+   if (resampledRate > 0)
+   {
+      juce::File diskFile = GetDiskCacheFile(key);
+      if (diskFile.existsAsFile())
+      {
+         try
+         {
+            FileStreamIn in(diskFile.getFullPathName().toStdString());
+            int rev;
+            std::string storedKey;
+            in >> rev;
+            LoadStateValidate(rev == kDiskCacheRev);
+            in >> storedKey;
+            LoadStateValidate(storedKey == key); //guard against hash collisions
+            auto data = std::make_shared<ChannelBuffer>(0);
+            int length;
+            data->Load(in, length, ChannelBuffer::LoadMode::kSetBufferSize);
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mNumDiskHits;
+            sampleRate = resampledRate;
+            AddEntry(key, data, sampleRate);
+            return data;
+         }
+         catch (LoadStateException&)
+         {
+            diskFile.deleteFile();
+         }
+      }
+   }
+
+   std::lock_guard<std::mutex> lock(mMutex);
+   ++mNumMisses;
+   return nullptr;
+}
+
+void SampleCache::Add(const juce::File& file, bool mono, std::shared_ptr<ChannelBuffer> data, float sampleRate, int resampledRate /*= 0*/)
+{
+   std::string key = GetKey(file, mono, resampledRate);
+
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      AddEntry(key, data, sampleRate);
+   }
+
+   if (resampledRate > 0)
+   {
+      SampleDecoder::Get()->RunInBackground([key, data]
+                                            {
+                                               juce::File diskFile = GetDiskCacheFile(key);
+                                               juce::File tempFile = diskFile.withFileExtension(".tmp");
+                                               diskFile.getParentDirectory().createDirectory();
+                                               {
+                                                  FileStreamOut out(tempFile.getFullPathName().toStdString());
+                                                  out << kDiskCacheRev;
+                                                  out << key;
+                                                  data->Save(out, data->BufferSize());
+                                               }
+                                               tempFile.moveFileTo(diskFile); //so a half-written file is never picked up
+                                            });
+   }
+}
+
+//call with mMutex held
+void SampleCache::AddEntry(const std::string& key, std::shared_ptr<ChannelBuffer> data, float sampleRate)
+{
+   auto iter = mEntries.find(key);
+   if (iter != mEntries.end())
+   {
+      mBytes -= iter->second.mBytes;
+      mLru.erase(iter->second.mLruPosition);
+      mEntries.erase(iter);
+   }
+
+   mLru.push_front(key);
+
+   Entry& entry = mEntries[key];
+   entry.mData = data;
+   entry.mSampleRate = sampleRate;
+   entry.mBytes = (long long)data->BufferSize() * data->NumActiveChannels() * sizeof(float);
+   entry.mLruPosition = mLru.begin();
+   mBytes += entry.mBytes;
+
+   EvictToBudget();
+}
+
+void SampleCache::EvictToBudget()
+{
+   //samples that are still using an evicted entry keep it alive until they're done with it
+   long long budget = (long long)UserPrefs.sample_cache_mb.Get() * 1024 * 1024;
+   while (mBytes > budget && mLru.size() > 1)
+   {
+      auto iter = mEntries.find(mLru.back());
+      mBytes -= iter->second.mBytes;
+      mEntries.erase(iter);
+      mLru.pop_back();
+      ++mNumEvictions;
+   }
+}
+
+void SampleCache::Clear()
+{
+   std::lock_guard<std::mutex> lock(mMutex);
+   mEntries.clear();
+   mLru.clear();
+   mBytes = 0;
+   juce::File(ofToDataPath(kDiskCacheDir)).deleteRecursively();
+}
+
+std::string SampleCache::GetStatsString()
+{
+   std::lock_guard<std::mutex> lock(mMutex);
+   return "sample cache: " + ofToString((int)mEntries.size()) + " files, " +
+          ofToString(int(mBytes / (1024 * 1024))) + "/" + ofToString(UserPrefs.sample_cache_mb.Get()) + " MB, " +
+          ofToString(mNumHits) + " hits, " + ofToString(mNumDiskHits) + " from disk, " + ofToString(mNumMisses) + " misses, " + ofToString(mNumEvictions) + " evictions";
+}
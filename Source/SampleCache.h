@@ -0,0 +1,78 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleCache.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "juce_core/juce_core.h"
+
+class ChannelBuffer;
+
+//decoded sample data shared between every Sample that reads the same file.
+//entries are keyed by path and modification time, and the least recently used ones are
+//dropped once the cache goes over the sample_cache_mb budget. the buffers are shared, so treat them as read-only.
+//data that was converted to another rate (resampledRate > 0) is also kept on disk, so it only gets converted once
+class SampleCache
+{
+public:
+   static SampleCache* Get();
+
+   std::shared_ptr<ChannelBuffer> Find(const juce::File& file, bool mono, float& sampleRate, int resampledRate = 0);
+   void Add(const juce::File& file, bool mono, std::shared_ptr<ChannelBuffer> data, float sampleRate, int resampledRate = 0);
+   void Clear();
+   std::string GetStatsString();
+
+private:
+   SampleCache() = default;
+
+   struct Entry
+   {
+      std::shared_ptr<ChannelBuffer> mData;
+      float mSampleRate{ 0 };
+      long long mBytes{ 0 };
+      std::list<std::string>::iterator mLruPosition;
+   };
+
+   static std::string GetKey(const juce::File& file, bool mono, int resampledRate);
+   static juce::File GetDiskCacheFile(const std::string& key);
+   void AddEntry(const std::string& key, std::shared_ptr<ChannelBuffer> data, float sampleRate);
+   void EvictToBudget();
+
+   std::map<std::string, Entry> mEntries;
+   std::list<std::string> mLru; //most recently used first
+   long long mBytes{ 0 };
+   int mNumHits{ 0 };
+   int mNumMisses{ 0 };
+   int mNumEvictions{ 0 };
+   int mNumDiskHits{ 0 };
+   std::mutex mMutex;
+};
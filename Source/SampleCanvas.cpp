@@ -101,10 +101,10 @@ void SampleCanvas::Process(double time)
 
    gWorkChannelBuffer.Clear();
 
-   const std::vector<CanvasElement*>& elements = mCanvas->GetElements();
-   for (int elemIdx = 0; elemIdx < elements.size(); ++elemIdx)
+   mCanvas->FillElementsInRange(canvasPos, GetCurPos(time + (bufferSize - 1) * gInvSampleRateMs), mElementsInRange);
+   for (auto* canvasElement : mElementsInRange)
    {
-      SampleCanvasElement* element = static_cast<SampleCanvasElement*>(elements[elemIdx]);
+      SampleCanvasElement* element = static_cast<SampleCanvasElement*>(canvasElement);
       Sample* clip = element->GetSample();
       float vol = element->GetVolume();
       if (clip == nullptr || element->IsMuted())
@@ -93,6 +93,7 @@ private:
    int mNumMeasures{ 4 };
    NoteInterval mInterval{ NoteInterval::kInterval_1n };
    DropdownList* mIntervalSelector{ nullptr };
+   std::vector<CanvasElement*> mElementsInRange;
 };
 
 #endif /* defined(__Bespoke__SampleCanvas__) */
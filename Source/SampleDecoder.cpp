@@ -0,0 +1,156 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleDecoder.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "SampleDecoder.h"
+#include "ChannelBuffer.h"
+#include "SincResampler.h"
+#include "SynthGlobals.h"
+
+#include <cmath>
+
+namespace
+{
+   const int kChunkSize = 65536;
+   const int kMaxDecodeThreads = 4;
+
+   class DecodeChunksJob : public juce::ThreadPoolJob
+   {
+   public:
+      DecodeChunksJob(juce::AudioFormatReader* reader, std::shared_ptr<SampleDecodeJob> state, std::shared_ptr<ChannelBuffer> decodeTo, double resampleRatio)
+      : juce::ThreadPoolJob("DecodeChunksJob")
+      , mReader(reader)
+      , mReadBuffer((int)reader->numChannels, kChunkSize)
+      , mState(state)
+      , mDecodeTo(decodeTo)
+      , mResampleRatio(resampleRatio)
+      {}
+
+      //decodes one chunk per call, then goes to the back of the pool's queue
+      JobStatus runJob() override
+      {
+         if (mState->mCancelled || shouldExit())
+         {
+            mState->mDoneEvent.signal();
+            return jobHasFinished;
+         }
+
+         int start = mState->mNumDecoded;
+         int length = MIN(kChunkSize, mState->mNumSamples - start);
+         if (length > 0)
+         {
+            mReader->read(&mReadBuffer, 0, length, start, true, true);
+
+            ChannelBuffer* data = mDecodeTo.get();
+            int numReadChannels = mReadBuffer.getNumChannels();
+            if (data->NumActiveChannels() == 1 && numReadChannels > 1)
+            {
+               //mix down to mono, like Sample::FinishRead()
+               float* dest = data->GetChannel(0) + start;
+               BufferCopy(dest, mReadBuffer.getReadPointer(0), length);
+               for (int ch = 1; ch < numReadChannels; ++ch)
+                  Add(dest, mReadBuffer.getReadPointer(ch), length);
+               Mult(dest, 1.0f / numReadChannels, length);
+            }
+            else
+            {
+               for (int ch = 0; ch < data->NumActiveChannels(); ++ch)
+                  BufferCopy(data->GetChannel(ch) + start, mReadBuffer.getReadPointer(MIN(ch, numReadChannels - 1)), length);
+            }
+
+            mState->mNumDecoded = start + length;
+         }
+
+         if (mState->mNumDecoded < mState->mNumSamples)
+            return jobNeedsRunningAgain;
+
+         if (mDecodeTo != mState->mData)
+         {
+            ChannelBuffer* data = mState->mData.get();
+            for (int ch = 0; ch < data->NumActiveChannels(); ++ch)
+               SincResampler::Process(mDecodeTo->GetChannel(ch), mState->mNumSamples, data->GetChannel(ch), data->BufferSize(), mResampleRatio);
+         }
+
+         mState->mFinished = true;
+         mState->mDoneEvent.signal();
+         return jobHasFinished;
+      }
+
+   private:
+      std::unique_ptr<juce::AudioFormatReader> mReader;
+      juce::AudioSampleBuffer mReadBuffer;
+      std::shared_ptr<SampleDecodeJob> mState;
+      std::shared_ptr<ChannelBuffer> mDecodeTo;
+      double mResampleRatio;
+   };
+}
+
+//static
+SampleDecoder* SampleDecoder::Get()
+{
+   static SampleDecoder sDecoder;
+   return &sDecoder;
+}
+
+SampleDecoder::SampleDecoder()
+: mPool(MAX(1, MIN(kMaxDecodeThreads, juce::SystemStats::getNumCpus() - 1)))
+{
+}
+
+SampleDecoder::~SampleDecoder()
+{
+   mPool.removeAllJobs(true, 1000);
+}
+
+std::shared_ptr<SampleDecodeJob> SampleDecoder::Decode(juce::AudioFormatReader* reader, std::shared_ptr<ChannelBuffer> data, double resampleRatio /*= 1*/)
+{
+   auto state = std::make_shared<SampleDecodeJob>();
+   state->mData = data;
+   state->mSampleRate = float(reader->sampleRate / resampleRatio);
+
+   std::shared_ptr<ChannelBuffer> decodeTo = data;
+   if (resampleRatio != 1)
+   {
+      state->mNumSamples = (int)reader->lengthInSamples;
+      state->mResampledRate = (int)lround(state->mSampleRate);
+      decodeTo = std::make_shared<ChannelBuffer>(state->mNumSamples);
+      decodeTo->SetNumActiveChannels(data->NumActiveChannels());
+      for (int ch = 0; ch < decodeTo->NumActiveChannels(); ++ch)
+         decodeTo->GetChannel(ch); //set up buffers here, the decode threads can't
+   }
+   else
+   {
+      state->mNumSamples = MIN((int)reader->lengthInSamples, data->BufferSize());
+   }
+
+   mPool.addJob(new DecodeChunksJob(reader, state, decodeTo, resampleRatio), true);
+   return state;
+}
+
+void SampleDecoder::RunInBackground(std::function<void()> job)
+{
+   mPool.addJob(job);
+}
@@ -0,0 +1,75 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleDecoder.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "juce_audio_formats/juce_audio_formats.h"
+
+class ChannelBuffer;
+
+//progress of a file being decoded in the background. the decode threads fill mData front to back,
+//and set mFinished once everything up to mNumSamples is in there. when resampling, the source is
+//decoded into a scratch buffer first, and mData is filled all at once at the end
+struct SampleDecodeJob
+{
+   float GetProgress() const { return mNumSamples > 0 ? float(mNumDecoded) / mNumSamples : 1; }
+   bool IsFinished() const { return mFinished; }
+   void Cancel() { mCancelled = true; }
+   void WaitUntilDone() { mDoneEvent.wait(); } //returns once the job is finished or has noticed it was cancelled
+
+   std::shared_ptr<ChannelBuffer> mData;
+   int mNumSamples{ 0 };
+   float mSampleRate{ 0 };
+   int mResampledRate{ 0 }; //the rate we converted to, or 0 if we didn't
+   std::atomic<int> mNumDecoded{ 0 };
+   std::atomic<bool> mFinished{ false };
+   std::atomic<bool> mCancelled{ false };
+   juce::WaitableEvent mDoneEvent{ true };
+};
+
+//a small pool of threads that decodes sample files in chunks. jobs take turns, so a long file
+//doesn't hold up the short ones queued behind it
+class SampleDecoder
+{
+public:
+   static SampleDecoder* Get();
+
+   //takes ownership of the reader. data must already be sized, with its channels set up.
+   //a resampleRatio other than 1 converts to the rate reader->sampleRate / resampleRatio
+   std::shared_ptr<SampleDecodeJob> Decode(juce::AudioFormatReader* reader, std::shared_ptr<ChannelBuffer> data, double resampleRatio = 1);
+   void RunInBackground(std::function<void()> job);
+
+private:
+   SampleDecoder();
+   ~SampleDecoder();
+
+   juce::ThreadPool mPool;
+};
@@ -52,7 +52,9 @@ SamplePlayer::SamplePlayer()
 : IAudioProcessor(gBufferSize)
 , mNoteInputBuffer(this)
 {
+   SetPollRate(kMaxPollRate);
    mYoutubeSearch[0] = 0;
+   mDrawBuffer.EnableWaveformPyramid();
 }
 
 void SamplePlayer::CreateUIControls()
@@ -0,0 +1,217 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleStream.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "SampleStream.h"
+#include "SynthGlobals.h"
+
+#include <mutex>
+#include <vector>
+
+namespace
+{
+   const int kRingMask = SampleStream::kRingLength - 1;
+   const int kPrefetchChunkSize = 16384;
+   const int kPrefetchIntervalMs = 5;
+   const int kSeekSlack = SampleStream::kRingLength / 2; //how far past the prefetched data we'll wait, rather than seeking
+
+   class Prefetcher : public juce::Thread
+   {
+   public:
+      Prefetcher()
+      : juce::Thread("SampleStream")
+      {}
+
+      ~Prefetcher() { stopThread(1000); }
+
+      static Prefetcher* Get()
+      {
+         static Prefetcher sPrefetcher;
+         return &sPrefetcher;
+      }
+
+      void AddStream(SampleStream* stream)
+      {
+         {
+            std::lock_guard<std::mutex> lock(mStreamsMutex);
+            mStreams.push_back(stream);
+         }
+         if (!isThreadRunning())
+            startThread();
+      }
+
+      void RemoveStream(SampleStream* stream)
+      {
+         std::lock_guard<std::mutex> lock(mStreamsMutex);
+         RemoveFromVector(stream, mStreams);
+      }
+
+      void run() override
+      {
+         while (!threadShouldExit())
+         {
+            {
+               std::lock_guard<std::mutex> lock(mStreamsMutex);
+               for (auto* stream : mStreams)
+                  stream->Prefetch();
+            }
+            wait(kPrefetchIntervalMs);
+         }
+      }
+
+   private:
+      std::vector<SampleStream*> mStreams;
+      std::mutex mStreamsMutex;
+   };
+}
+
+SampleStream::SampleStream(juce::AudioFormatReader* reader, ChannelBuffer* head, int numSamples)
+: mReader(reader)
+, mReadBuffer((int)reader->numChannels, kPrefetchChunkSize)
+, mHead(head)
+, mHeadLength(head->BufferSize())
+, mNumSamples(numSamples)
+, mRingStart(mHeadLength)
+, mRingEnd(mHeadLength)
+, mSeekTarget(mHeadLength)
+{
+   mRing.SetNumActiveChannels(mHead->NumActiveChannels());
+   for (int ch = 0; ch < mRing.NumActiveChannels(); ++ch)
+      mRing.GetChannel(ch); //set up buffer
+
+   Prefetcher::Get()->AddStream(this);
+}
+
+SampleStream::~SampleStream()
+{
+   Prefetcher::Get()->RemoveStream(this);
+}
+
+//make sure the ring is filling from around this position, cueing up a seek if we've jumped
+void SampleStream::Cue(double offset)
+{
+   int target = MAX(int(offset) - 1, mHeadLength); //while we're in the head, cue up whatever follows it
+
+   if (IsSeekPending())
+   {
+      if (target < mSeekTarget || target > mSeekTarget + kSeekSlack)
+         RequestSeek(target);
+      return;
+   }
+
+   if (target < mRingStart || target > mRingEnd + kSeekSlack)
+      RequestSeek(target);
+}
+
+void SampleStream::RequestSeek(int frame)
+{
+   mSeekTarget = frame;
+   ++mSeekGeneration;
+}
+
+float SampleStream::GetFrame(int frame, int channel)
+{
+   if (frame < mHeadLength)
+      return mHead->GetChannel(channel)[frame];
+
+   if (!IsSeekPending() && frame >= mRingStart && frame < mRingEnd)
+      return mRing.GetChannel(channel)[frame & kRingMask];
+
+   ++mNumUnderruns;
+   return 0;
+}
+
+float SampleStream::GetInterpolatedSample(double offset, int channel)
+{
+   FloatWrap(offset, mNumSamples);
+   int pos = int(offset);
+   int posNext = int(offset + 1) % mNumSamples;
+
+   float a = offset - pos;
+   return (1 - a) * GetFrame(pos, channel) + a * GetFrame(posNext, channel);
+}
+
+//we're done with everything before this position, so the prefetch thread can reuse that space
+void SampleStream::Release(double offset)
+{
+   if (IsSeekPending())
+      return;
+
+   int start = mRingStart;
+   int newStart = MIN(MAX(int(offset) - 1, start), mRingEnd.load());
+   mRingStart = newStart;
+}
+
+void SampleStream::Prefetch()
+{
+   int seekGeneration = mSeekGeneration;
+   if (seekGeneration != mAckedSeekGeneration)
+   {
+      //the audio thread leaves the ring alone until we acknowledge
+      int target = mSeekTarget;
+      mRingStart = target;
+      mRingEnd = target;
+      mAckedSeekGeneration = seekGeneration;
+   }
+
+   while (true)
+   {
+      int start = mRingStart;
+      int end = mRingEnd;
+      int length = MIN(MIN(kRingLength - (end - start), mNumSamples - end), kPrefetchChunkSize);
+      if (length <= 0 || IsSeekPending())
+         break;
+
+      mReader->read(&mReadBuffer, 0, length, end, true, true);
+
+      int numChannels = mRing.NumActiveChannels();
+      for (int ch = 0; ch < numChannels; ++ch)
+      {
+         float* ring = mRing.GetChannel(ch);
+         int pos = end & kRingMask;
+         int firstLength = MIN(length, kRingLength - pos);
+         if (numChannels == 1 && mReadBuffer.getNumChannels() > 1)
+         {
+            //mixed down to mono, like Sample::FinishRead()
+            for (int i = 0; i < length; ++i)
+            {
+               float sum = 0;
+               for (int readCh = 0; readCh < mReadBuffer.getNumChannels(); ++readCh)
+                  sum += mReadBuffer.getSample(readCh, i);
+               ring[(pos + i) & kRingMask] = sum / mReadBuffer.getNumChannels();
+            }
+         }
+         else
+         {
+            const float* source = mReadBuffer.getReadPointer(MIN(ch, mReadBuffer.getNumChannels() - 1));
+            BufferCopy(ring + pos, source, firstLength);
+            BufferCopy(ring, source + firstLength, length - firstLength);
+         }
+      }
+
+      mRingEnd = end + length;
+   }
+}
@@ -0,0 +1,77 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleStream.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "ChannelBuffer.h"
+
+#include "juce_audio_formats/juce_audio_formats.h"
+
+//plays a file from disk. the first part lives in memory (the head), and a background thread
+//keeps a ring buffer filled ahead of the playhead. Cue(), GetInterpolatedSample() and Release()
+//are for the audio thread only
+class SampleStream
+{
+public:
+   SampleStream(juce::AudioFormatReader* reader, ChannelBuffer* head, int numSamples);
+   ~SampleStream();
+
+   void Cue(double offset);
+   float GetInterpolatedSample(double offset, int channel);
+   void Release(double offset);
+   int GetNumUnderruns() const { return mNumUnderruns; }
+
+   void Prefetch(); //prefetch thread
+
+   static const int kRingLength = 1 << 17;
+
+private:
+   float GetFrame(int frame, int channel);
+   bool IsSeekPending() const { return mSeekGeneration != mAckedSeekGeneration; }
+   void RequestSeek(int frame);
+
+   std::unique_ptr<juce::AudioFormatReader> mReader;
+   juce::AudioSampleBuffer mReadBuffer;
+   ChannelBuffer* mHead;
+   int mHeadLength;
+   int mNumSamples;
+
+   //the ring holds source frames [mRingStart, mRingEnd). the prefetch thread advances the end, the audio thread advances the start
+   ChannelBuffer mRing{ kRingLength };
+   std::atomic<int> mRingStart;
+   std::atomic<int> mRingEnd;
+
+   //seeks are requested by the audio thread and carried out by the prefetch thread
+   std::atomic<int> mSeekTarget;
+   std::atomic<int> mSeekGeneration{ 0 };
+   std::atomic<int> mAckedSeekGeneration{ 0 };
+
+   std::atomic<int> mNumUnderruns{ 0 };
+};
@@ -53,6 +53,8 @@ bool SampleVoice::Process(double time, ChannelBuffer* out, int oversampling)
        mVoiceParams->mSampleLength == 0)
       return false;
 
+   UpdateModulationBlocks();
+
    float volSq = mVoiceParams->mVol * mVoiceParams->mVol;
 
    for (int pos = 0; pos < out->BufferSize(); ++pos)
@@ -52,6 +52,7 @@ Sampler::Sampler()
 , mPassthroughCheckbox(nullptr)
 , mWriteBuffer(gBufferSize)
 {
+   SetPollRate(kMaxPollRate);
    mSampleData = new float[MAX_SAMPLER_LENGTH]; //store up to 2 seconds
    Clear(mSampleData, MAX_SAMPLER_LENGTH);
 
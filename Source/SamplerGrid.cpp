@@ -37,6 +37,7 @@
 SamplerGrid::SamplerGrid()
 : IAudioProcessor(gBufferSize)
 {
+   SetPollRate(kMaxPollRate);
 }
 
 void SamplerGrid::CreateUIControls()
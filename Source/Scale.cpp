@@ -41,6 +41,7 @@ namespace
 
 Scale::Scale()
 {
+   SetPollRate(kMaxPollRate);
    assert(TheScale == nullptr);
    TheScale = this;
    SetName("scale");
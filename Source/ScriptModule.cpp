@@ -85,6 +85,7 @@ ofxJSONElement ScriptModule::sStyleJSON;
 
 ScriptModule::ScriptModule()
 {
+   SetPollRate(kMaxPollRate);
    CheckIfPythonEverSuccessfullyInitialized();
    if ((TheSynth->IsLoadingState() || Prefab::sLoadingPrefab) && sHasPythonEverSuccessfullyInitialized)
       InitializePythonIfNecessary();
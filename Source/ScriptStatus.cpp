@@ -48,6 +48,7 @@ namespace py = pybind11;
 
 ScriptStatus::ScriptStatus()
 {
+   SetPollRate(10);
    ScriptModule::CheckIfPythonEverSuccessfullyInitialized();
    if ((TheSynth->IsLoadingState() || Prefab::sLoadingPrefab) && ScriptModule::sHasPythonEverSuccessfullyInitialized)
       ScriptModule::InitializePythonIfNecessary();
@@ -43,6 +43,7 @@ SeaOfGrain::SeaOfGrain()
 : IAudioProcessor(gBufferSize)
 , mRecordBuffer(10 * gSampleRate)
 {
+   SetPollRate(kMaxPollRate);
    mSample = new Sample();
 
    for (int i = 0; i < kNumMPEVoices; ++i)
@@ -433,11 +434,14 @@ void SeaOfGrain::GrainMPEVoice::Process(ChannelBuffer* output, int bufferSize)
    if (!mADSR.IsDone(gTime) && mOwner->GetSourceBuffer()->BufferSize() > 0)
    {
       double time = gTime;
+      const float* pitchBendBlock = mPitchBend ? mPitchBend->GetBlock() : nullptr;
+      const float* pressureBlock = mPressure ? mPressure->GetBlock() : nullptr;
+      const float* modWheelBlock = mModWheel ? mModWheel->GetBlock() : nullptr;
       for (int i = 0; i < bufferSize; ++i)
       {
-         float pitchBend = mPitchBend ? mPitchBend->GetValue(i) : 0;
-         float pressure = mPressure ? mPressure->GetValue(i) : 0;
-         float modwheel = mModWheel ? mModWheel->GetValue(i) : 0;
+         float pitchBend = pitchBendBlock ? pitchBendBlock[i] : 0;
+         float pressure = pressureBlock ? pressureBlock[i] : 0;
+         float modwheel = modWheelBlock ? modWheelBlock[i] : 0;
          if (pressure > 0)
          {
             mGranulator.mGrainOverlap = ofMap(pressure * pressure, 0, 1, 3, MAX_GRAINS);
@@ -0,0 +1,95 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SincResampler.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "SincResampler.h"
+#include "ChannelBuffer.h"
+#include "SynthGlobals.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+   const int kNumTaps = 32; //zero crossings on each side = kNumTaps / 2
+   const int kHalfTaps = kNumTaps / 2;
+   const int kNumPhases = 256;
+
+   //one set of taps per fractional position, with one extra so we can interpolate between neighboring phases
+   std::vector<float> BuildTable(double cutoff)
+   {
+      std::vector<float> table((kNumPhases + 1) * kNumTaps);
+      for (int phase = 0; phase <= kNumPhases; ++phase)
+      {
+         double frac = double(phase) / kNumPhases;
+         for (int tap = 0; tap < kNumTaps; ++tap)
+         {
+            double x = tap - (kHalfTaps - 1) - frac; //distance from the tap to the output position, in source samples
+            double sinc = x == 0 ? 1 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+            double w = x / kHalfTaps;
+            double window = fabs(w) >= 1 ? 0 : .42 + .5 * cos(M_PI * w) + .08 * cos(2 * M_PI * w); //blackman
+            table[phase * kNumTaps + tap] = float(cutoff * sinc * window);
+         }
+      }
+      return table;
+   }
+}
+
+void SincResampler::Process(const float* input, int inputLength, float* output, int outputLength, double ratio)
+{
+   //when going down in rate, drop the cutoff below the new nyquist so we don't alias
+   double cutoff = MIN(1.0, 1.0 / ratio) * .95;
+   std::vector<float> table = BuildTable(cutoff);
+
+   for (int i = 0; i < outputLength; ++i)
+   {
+      double pos = i * ratio;
+      int center = int(pos);
+      double phase = (pos - center) * kNumPhases;
+      int phaseIndex = int(phase);
+      float a = float(phase - phaseIndex);
+      const float* taps0 = &table[phaseIndex * kNumTaps];
+      const float* taps1 = taps0 + kNumTaps;
+
+      int first = center - (kHalfTaps - 1);
+      int tapStart = MAX(0, -first);
+      int tapEnd = MIN(kNumTaps, inputLength - first);
+      float sum = 0;
+      for (int tap = tapStart; tap < tapEnd; ++tap)
+         sum += input[first + tap] * (taps0[tap] + a * (taps1[tap] - taps0[tap]));
+      output[i] = sum;
+   }
+}
+
+std::shared_ptr<ChannelBuffer> SincResampler::Process(ChannelBuffer* input, int inputLength, double ratio)
+{
+   int outputLength = GetOutputLength(inputLength, ratio);
+   auto output = std::make_shared<ChannelBuffer>(outputLength);
+   output->SetNumActiveChannels(input->NumActiveChannels());
+   for (int ch = 0; ch < input->NumActiveChannels(); ++ch)
+      Process(input->GetChannel(ch), inputLength, output->GetChannel(ch), outputLength, ratio);
+   return output;
+}
@@ -0,0 +1,42 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SincResampler.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <memory>
+
+class ChannelBuffer;
+
+//windowed-sinc sample rate conversion, for converting samples to the engine rate once when they load
+//rather than interpolating every time they play. ratio is source rate / destination rate
+class SincResampler
+{
+public:
+   static int GetOutputLength(int inputLength, double ratio) { return int(inputLength / ratio); }
+   static void Process(const float* input, int inputLength, float* output, int outputLength, double ratio);
+   static std::shared_ptr<ChannelBuffer> Process(ChannelBuffer* input, int inputLength, double ratio);
+};
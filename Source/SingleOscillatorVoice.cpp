@@ -51,6 +51,8 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
    if (IsDone(time))
       return false;
 
+   UpdateModulationBlocks();
+
    for (int u = 0; u < mVoiceParams->mUnison && u < kMaxUnison; ++u)
       mOscData[u].mOsc.SetType(mVoiceParams->mOscType);
 
@@ -587,6 +587,21 @@ std::string FloatSlider::GetDisplayValue(float val) const
    return ofToString(displayVar, decDigits);
 }
 
+size_t FloatSlider::GetRenderHash()
+{
+   size_t hash = IUIControl::GetRenderHash();
+   HashCombine(hash, mMin);
+   HashCombine(hash, mMax);
+   HashCombine(hash, mSmooth);
+   HashCombine(hash, mSmoothTarget);
+   if (mModulator && mModulator->Active())
+   {
+      HashCombine(hash, mModulator->GetMin());
+      HashCombine(hash, mModulator->GetMax());
+   }
+   return hash;
+}
+
 void FloatSlider::DoCompute(int samplesIn /*= 0*/)
 {
    if (mLastComputeTime == gTime && mLastComputeSamplesIn == samplesIn)
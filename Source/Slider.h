@@ -111,6 +111,7 @@ public:
    float GetValue() const override;
    std::string GetDisplayValue(float val) const override;
    float GetMidiValue() const override;
+   size_t GetRenderHash() override;
    void GetRange(float& min, float& max) override
    {
       min = mMin;
@@ -30,7 +30,7 @@
 #include <iostream>
 #include "IAudioProcessor.h"
 #include "IDrawableModule.h"
-#include "RollingBuffer.h"
+#include "VizBuffer.h"
 #include "Ramp.h"
 #include "PatchCableSource.h"
 
@@ -55,6 +55,7 @@ public:
 private:
    //IDrawableModule
    void DrawModule() override;
+   bool CanCacheDrawing() const override { return true; }
    void GetModuleDimensions(float& w, float& h) override
    {
       w = 80;
@@ -62,6 +63,6 @@ private:
    }
    bool Enabled() const override { return mEnabled; }
 
-   RollingBuffer mVizBuffer2;
+   VizBuffer mVizBuffer2;
    PatchCableSource* mPatchCableSource2{ nullptr };
 };
@@ -38,6 +38,7 @@ namespace
 StepSequencer::StepSequencer()
 : mFlusher(this)
 {
+   SetPollRate(kMaxPollRate);
    mFlusher.SetInterval(mStepInterval);
 
    mMetaStepMasks = new juce::uint32[META_STEP_MAX * NUM_STEPSEQ_ROWS];
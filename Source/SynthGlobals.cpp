@@ -36,6 +36,7 @@
 #include "PatchCable.h"
 #include "PatchCableSource.h"
 #include "ChannelBuffer.h"
+#include "WaveformPyramid.h"
 #include "IPulseReceiver.h"
 #include "exprtk/exprtk.hpp"
 #include "UserPrefs.h"
@@ -130,15 +131,21 @@ std::string GetBuildInfoString()
    juce::JUCEApplication::getInstance()->getApplicationVersion().toStdString() + " (" + std::string(__DATE__) + " " + std::string(__TIME__) + ")";
 }
 
+static void DrawWaveform(float width, float height, const float* buffer, float start, float end, float pos, float vol, ofColor color, int wraparoundFrom, int wraparoundTo, int bufferSize, const WaveformPyramid* pyramid, int pyramidChannel);
+
 void DrawAudioBuffer(float width, float height, ChannelBuffer* buffer, float start, float end, float pos, float vol /*=1*/, ofColor color /*=ofColor::black*/, int wraparoundFrom /*= -1*/, int wraparoundTo /*= 0*/)
 {
    ofPushMatrix();
    if (buffer != nullptr)
    {
+      WaveformPyramid* pyramid = buffer->GetWaveformPyramid();
+      if (pyramid != nullptr)
+         pyramid->Update(buffer);
+
       int numChannels = buffer->NumActiveChannels();
       for (int i = 0; i < numChannels; ++i)
       {
-         DrawAudioBuffer(width, height / numChannels, buffer->GetChannel(i), start, MIN(end, buffer->BufferSize()), pos, vol, color, wraparoundFrom, wraparoundTo, buffer->BufferSize());
+         DrawWaveform(width, height / numChannels, buffer->GetChannel(i), start, MIN(end, buffer->BufferSize()), pos, vol, color, wraparoundFrom, wraparoundTo, buffer->BufferSize(), pyramid, i);
          ofTranslate(0, height / numChannels);
       }
    }
@@ -146,6 +153,11 @@ void DrawAudioBuffer(float width, float height, ChannelBuffer* buffer, float sta
 }
 
 void DrawAudioBuffer(float width, float height, const float* buffer, float start, float end, float pos, float vol /*=1*/, ofColor color /*=ofColor::black*/, int wraparoundFrom /*= -1*/, int wraparoundTo /*= 0*/, int bufferSize /*=-1*/)
+{
+   DrawWaveform(width, height, buffer, start, end, pos, vol, color, wraparoundFrom, wraparoundTo, bufferSize, nullptr, 0);
+}
+
+static void DrawWaveform(float width, float height, const float* buffer, float start, float end, float pos, float vol, ofColor color, int wraparoundFrom, int wraparoundTo, int bufferSize, const WaveformPyramid* pyramid, int pyramidChannel)
 {
    vol = MAX(.1f, vol); //make sure we at least draw something if there is waveform data
 
@@ -176,23 +188,33 @@ void DrawAudioBuffer(float width, float height, const float* buffer, float start
          float step = width > 0 ? kStepSize : -kStepSize;
          float samplesPerStep = length / width * step;
 
+         //once a column covers a few summary blocks, reading the pyramid is cheaper and exact
+         bool usePyramid = pyramid != nullptr && wraparoundFrom == -1 && samplesPerStep >= WaveformPyramid::kBaseBlockSize * 2;
+
          ofSetColor(color);
 
+         ofBeginLines();
          for (float i = 0; abs(i) < abs(width); i += step)
          {
             float mag = 0;
             int position = i / width * length + start;
-            //rms
-            int j;
-            int inc = 1 + samplesPerStep / 100;
-            for (j = 0; j < samplesPerStep; j += inc)
+            if (usePyramid)
+            {
+               WaveformPyramid::Block block = pyramid->GetRange(pyramidChannel, position, position + int(samplesPerStep));
+               mag = MAX(-block.mMin, block.mMax);
+            }
+            else
             {
-               int sampleIdx = position + j;
-               if (wraparoundFrom != -1 && sampleIdx > wraparoundFrom)
-                  sampleIdx = sampleIdx - wraparoundFrom + wraparoundTo;
-               if (bufferSize > 0)
-                  sampleIdx %= bufferSize;
-               mag = MAX(mag, fabsf(buffer[sampleIdx]));
+               int inc = 1 + samplesPerStep / 100;
+               for (int j = 0; j < samplesPerStep; j += inc)
+               {
+                  int sampleIdx = position + j;
+                  if (wraparoundFrom != -1 && sampleIdx > wraparoundFrom)
+                     sampleIdx = sampleIdx - wraparoundFrom + wraparoundTo;
+                  if (bufferSize > 0)
+                     sampleIdx %= bufferSize;
+                  mag = MAX(mag, fabsf(buffer[sampleIdx]));
+               }
             }
             mag = pow(mag, .25f);
             mag *= height / 2 * vol;
@@ -207,8 +229,9 @@ void DrawAudioBuffer(float width, float height, const float* buffer, float start
             }
             if (mag == 0)
                mag = .1f;
-            ofLine(i, height / 2 - mag, i, height / 2 + mag);
+            ofAddLine(i, height / 2 - mag, i, height / 2 + mag);
          }
+         ofEndLines();
 
          if (pos != -1)
          {
@@ -524,18 +547,20 @@ void DrawLissajous(RollingBuffer* buffer, float x, float y, float w, float h, fl
       secondChannel = 0;
 
    ofSetColor(r * 255, g * 255, b * 255, 70);
-   ofBeginShape();
+   static std::vector<ofVec2f> sPoints;
+   sPoints.clear();
    const int delaySamps = 90;
    int numPoints = MIN(buffer->Size() - delaySamps - 1, .02f * gSampleRate);
+   float scale = .8f * MIN(w, h);
    for (int i = 100; i < numPoints; ++i)
    {
-      float vx = x + w / 2 + buffer->GetSample(i, 0) * .8f * MIN(w, h);
-      float vy = y + h / 2 + buffer->GetSample(i + delaySamps, secondChannel) * .8f * MIN(w, h);
+      float vx = x + w / 2 + buffer->GetSample(i, 0) * scale;
+      float vy = y + h / 2 + buffer->GetSample(i + delaySamps, secondChannel) * scale;
       //float alpha = 1 - (i/float(numPoints));
       //ofSetColor(r*255,g*255,b*255,alpha*alpha*255);
-      ofVertex(vx, vy);
+      sPoints.push_back(ofVec2f(vx, vy));
    }
-   ofEndShape();
+   ofPolyline(sPoints.data(), (int)sPoints.size());
 
    ofPopStyle();
 }
@@ -233,6 +233,12 @@ inline static int DeterministicRandom(int seed, int index)
    return (int)x;
 }
 
+//the sample in the current buffer that an event time lands on
+inline static int GetBufferSampleIndex(double time)
+{
+   return (int)round((time - gTime) * gSampleRateMs);
+}
+
 inline static std::string GetPathSeparator()
 {
 #if BESPOKE_WINDOWS
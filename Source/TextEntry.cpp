@@ -596,6 +596,13 @@ std::string TextEntry::GetDisplayValue(float val) const
    return mString;
 }
 
+size_t TextEntry::GetRenderHash()
+{
+   size_t hash = IUIControl::GetRenderHash();
+   HashCombine(hash, std::string(mString));
+   return hash;
+}
+
 void TextEntry::AcceptEntry(bool pressedEnter)
 {
    if (!pressedEnter && mRequireEnterToAccept)
@@ -107,6 +107,7 @@ public:
    bool IsSliderControl() override { return false; }
    bool IsButtonControl() override { return false; }
    bool IsTextEntry() const override { return true; }
+   size_t GetRenderHash() override;
 
 protected:
    ~TextEntry(); //protected so that it can't be created on the stack
@@ -0,0 +1,100 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    TimedEventQueue.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+//events waiting for their time to come, kept in a binary heap so pushing and popping are O(log n).
+//all of the storage is allocated up front, so it never allocates on the audio thread.
+//once it holds capacity events, new ones are dropped and counted.
+//not thread safe, push and pop from the same thread
+template <typename T>
+class TimedEventQueue
+{
+public:
+   explicit TimedEventQueue(int capacity)
+   : mCapacity(capacity)
+   {
+      mEvents.reserve(capacity);
+   }
+
+   //events at the same time come out lowest priority first, then in the order they were pushed
+   bool Push(double time, const T& event, int priority = 0)
+   {
+      if ((int)mEvents.size() >= mCapacity)
+      {
+         ++mNumDropped;
+         return false;
+      }
+
+      mEvents.push_back({ time, priority, mNextSequence++, event });
+      std::push_heap(mEvents.begin(), mEvents.end(), IsLater);
+      return true;
+   }
+
+   bool IsEmpty() const { return mEvents.empty(); }
+   double GetNextTime() const { return mEvents.front().mTime; }
+   const T& GetNext() const { return mEvents.front().mEvent; }
+
+   void PopNext()
+   {
+      std::pop_heap(mEvents.begin(), mEvents.end(), IsLater);
+      mEvents.pop_back();
+   }
+
+   void Clear() { mEvents.clear(); }
+
+   int GetCapacity() const { return mCapacity; }
+   int GetNumDropped() const { return mNumDropped; } //safe to read from any thread
+
+private:
+   struct Entry
+   {
+      double mTime;
+      int mPriority;
+      unsigned int mSequence;
+      T mEvent;
+   };
+
+   //heap ordering, so the earliest event ends up at the front
+   static bool IsLater(const Entry& a, const Entry& b)
+   {
+      if (a.mTime != b.mTime)
+         return a.mTime > b.mTime;
+      if (a.mPriority != b.mPriority)
+         return a.mPriority > b.mPriority;
+      return int(a.mSequence - b.mSequence) > 0; //still ordered correctly when the sequence wraps
+   }
+
+   std::vector<Entry> mEvents;
+   int mCapacity;
+   unsigned int mNextSequence{ 0 };
+   std::atomic<int> mNumDropped{ 0 };
+};
@@ -58,6 +58,7 @@ Transport::Transport()
 , mLoopStartMeasure(-1)
 , mLoopEndMeasure(-1)
 {
+   SetPollRate(kMaxPollRate);
    assert(TheTransport == nullptr);
    TheTransport = this;
 
@@ -146,14 +147,31 @@ void Transport::Advance(double ms)
 
    assert(amount > 0);
 
+   bool measureJumped = mMeasureTime != mScheduledMeasureTime; //moved by something other than the last advance
+
    mMeasureTime += amount;
 
    if (mLoopStartMeasure != -1 && (GetMeasure(gTime) < mLoopStartMeasure || GetMeasure(gTime) >= mLoopEndMeasure))
+   {
       SetMeasure(mLoopStartMeasure);
+      measureJumped = true;
+   }
 
    if (TheChaosEngine)
       TheChaosEngine->AudioUpdate();
 
+   if (measureJumped || mTempo != mScheduledTempo || mTimeSigTop != mScheduledTimeSigTop || mTimeSigBottom != mScheduledTimeSigBottom ||
+       mSwing != mScheduledSwing || mSwingInterval != mScheduledSwingInterval)
+   {
+      ++mScheduleGeneration;
+      mScheduledTempo = mTempo;
+      mScheduledTimeSigTop = mTimeSigTop;
+      mScheduledTimeSigBottom = mTimeSigBottom;
+      mScheduledSwing = mSwing;
+      mScheduledSwingInterval = mSwingInterval;
+   }
+   mScheduledMeasureTime = mMeasureTime;
+
    UpdateListeners(ms);
 
    for (std::list<IAudioPoller*>::iterator i = mAudioPollers.begin(); i != mAudioPollers.end(); ++i)
@@ -590,9 +608,11 @@ double Transport::GetMeasureFraction(NoteInterval interval)
 
 void Transport::UpdateListeners(double jumpMs)
 {
+   const double kScheduleMarginMs = .1; //wake up a little early, so rounding can't push us past a step
+
    for (std::list<TransportListenerInfo>::iterator i = mListeners.begin(); i != mListeners.end(); ++i)
    {
-      const TransportListenerInfo& info = *i;
+      TransportListenerInfo& info = *i;
       if (info.mInterval != kInterval_None &&
           info.mInterval != kInterval_Free)
       {
@@ -602,35 +622,121 @@ void Transport::UpdateListeners(double jumpMs)
 
          double checkTime = gTime + lookaheadMs;
 
-         double remainderMs;
+         if (info.IsScheduled(mScheduleGeneration) && checkTime < info.mNextEventTime - kScheduleMarginMs)
+            continue;
+
          int oldStep = GetQuantized(checkTime - jumpMs, &info);
-         int newStep = GetQuantized(checkTime, &info, &remainderMs);
+         int newStep = GetQuantized(checkTime, &info);
          if (oldStep != newStep)
-         {
-            double time = checkTime - remainderMs + .0001; //TODO(Ryan) investigate this fudge number. I would think that subtracting remainderMs from checkTime would give me a number that gives me the same GetQuantized() result with a zero remainder, but sometimes it is just short of the correct quantization
-            /*ofLog() << oldStep << " " << newStep << " " << remainderMs << " " << jumpMs << " " << checkTime << " " << time << " " << GetQuantized(checkTime, info.mInterval) << " " << GetQuantized(time, info.mInterval);
-            if (GetQuantized(checkTime + offsetMs, info.mInterval) != GetQuantized(time + offsetMs, info.mInterval))
-            {
-               double aboveRemainderMs;
-               GetQuantized(checkTime + offsetMs, info.mInterval, &aboveRemainderMs);
-               double remainderShouldBeZeroMs;
-               GetQuantized(time + offsetMs, info.mInterval, &remainderShouldBeZeroMs);
-               ofLog() << remainderShouldBeZeroMs;
-            }*/
-            //assert(GetQuantized(checkTime + offsetMs, info.mInterval) == GetQuantized(time + offsetMs, info.mInterval));
-            info.mListener->OnTimeEvent(time);
-         }
+            info.mListener->OnTimeEvent(GetEventTime(checkTime - jumpMs, checkTime, oldStep, &info));
+
+         info.SetScheduled(GetNextEventTime(checkTime, &info), mScheduleGeneration);
       }
    }
 }
 
-void Transport::OnDrumEvent(NoteInterval drumEvent)
+//the time of the first sample after oldTime where this listener has moved on from oldStep.
+//it lands on the same sample grid that Process() walks through, so anything started at this time starts exactly on that sample,
+//and GetQuantized() at this time is guaranteed to give the new step. works with swing and offsets, since it only relies on GetQuantized()
+double Transport::GetEventTime(double oldTime, double newTime, int oldStep, const TransportListenerInfo* listenerInfo)
+{
+   int lowSample = (int)floor((oldTime - gTime) * gSampleRateMs);
+   int highSample = (int)ceil((newTime - gTime) * gSampleRateMs);
+   while (highSample - lowSample > 1)
+   {
+      int sample = (lowSample + highSample) / 2;
+      if (GetQuantized(gTime + sample * gInvSampleRateMs, listenerInfo) != oldStep)
+         highSample = sample;
+      else
+         lowSample = sample;
+   }
+   return gTime + highSample * gInvSampleRateMs;
+}
+
+//the earliest time after this that GetQuantized() could give a different step for this listener.
+//with swing applied this is only a lower bound, so the listener may get checked a few times before its step actually changes
+double Transport::GetNextEventTime(double time, const TransportListenerInfo* listenerInfo)
+{
+   double offsetMs;
+   if (listenerInfo->mOffsetInfo.mOffsetIsInMs)
+      offsetMs = listenerInfo->mOffsetInfo.mOffset;
+   else
+      offsetMs = listenerInfo->mOffsetInfo.mOffset * MsPerBar();
+
+   double measureTime = GetMeasureTime(time + offsetMs);
+   if (measureTime < 0)
+      return time; //keep checking every block until we're into the first measure
+
+   double measurePos = measureTime - floor(measureTime);
+   double pos = Swing(measurePos);
+   double timeSigRatio = double(mTimeSigTop) / mTimeSigBottom;
+
+   //mirrors the cases in GetQuantized()
+   NoteInterval interval = listenerInfo->mInterval;
+   double stepsPerMeasure;
+   double stepPos;
+   switch (interval)
+   {
+      case kInterval_1n:
+      case kInterval_2:
+      case kInterval_3:
+      case kInterval_4:
+      case kInterval_8:
+      case kInterval_16:
+      case kInterval_32:
+      case kInterval_64:
+         stepsPerMeasure = 0; //only changes on a measure
+         stepPos = 0;
+         break;
+      case kInterval_2n:
+      case kInterval_2nt:
+      case kInterval_4n:
+      case kInterval_4nt:
+      case kInterval_8n:
+      case kInterval_8nt:
+      case kInterval_16n:
+      case kInterval_16nt:
+      case kInterval_32n:
+      case kInterval_32nt:
+      case kInterval_64n:
+         stepsPerMeasure = timeSigRatio * CountInStandardMeasure(interval);
+         stepPos = pos * stepsPerMeasure;
+         break;
+      case kInterval_4nd:
+      case kInterval_8nd:
+      case kInterval_16nd:
+         stepsPerMeasure = timeSigRatio / GetMeasureFraction(interval);
+         stepPos = (floor(measureTime) + pos * timeSigRatio) / GetMeasureFraction(interval);
+         break;
+      case kInterval_CustomDivisor:
+         stepsPerMeasure = listenerInfo->mCustomDivisor;
+         stepPos = pos * stepsPerMeasure;
+         break;
+      default:
+         return time;
+   }
+
+   double measuresUntilEvent = 1 - measurePos;
+   if (stepsPerMeasure > 0)
+   {
+      //swing moves through a slice at a varying speed, so assume the steepest part of its curve
+      double swingDouble = mSwing;
+      double term = (.5 - swingDouble) / (swingDouble * swingDouble - swingDouble);
+      double maxSwingSlope = 1 + fabs(term);
+      double stepsUntilEvent = 1 - (stepPos - floor(stepPos));
+      measuresUntilEvent = std::min(measuresUntilEvent, stepsUntilEvent / (stepsPerMeasure * maxSwingSlope));
+   }
+
+   return time + measuresUntilEvent * MsPerBar();
+}
+
+void Transport::OnDrumEvent(NoteInterval drumEvent, double time)
 {
    for (std::list<TransportListenerInfo>::iterator i = mListeners.begin(); i != mListeners.end(); ++i)
    {
       const TransportListenerInfo& info = *i;
       if (info.mInterval == drumEvent)
-         info.mListener->OnTimeEvent(0); //TODO(Ryan) calc sample offset
+         info.mListener->OnTimeEvent(time);
    }
 }
 
@@ -90,11 +90,37 @@ struct TransportListenerInfo
    , mCustomDivisor(8)
    {}
 
+   //modules edit the fields above in place, so a schedule only holds while they match what it was worked out from
+   bool IsScheduled(int scheduleGeneration) const
+   {
+      return mScheduleGeneration == scheduleGeneration &&
+             mScheduledInterval == mInterval &&
+             mScheduledOffsetInfo.mOffset == mOffsetInfo.mOffset &&
+             mScheduledOffsetInfo.mOffsetIsInMs == mOffsetInfo.mOffsetIsInMs &&
+             mScheduledCustomDivisor == mCustomDivisor;
+   }
+
+   void SetScheduled(double nextEventTime, int scheduleGeneration)
+   {
+      mNextEventTime = nextEventTime;
+      mScheduleGeneration = scheduleGeneration;
+      mScheduledInterval = mInterval;
+      mScheduledOffsetInfo = mOffsetInfo;
+      mScheduledCustomDivisor = mCustomDivisor;
+   }
+
    ITimeListener* mListener;
    NoteInterval mInterval;
    OffsetInfo mOffsetInfo;
    bool mUseEventLookahead;
    int mCustomDivisor;
+
+   //the transport doesn't check this listener for events until mNextEventTime
+   double mNextEventTime{ 0 };
+   int mScheduleGeneration{ -1 };
+   NoteInterval mScheduledInterval{ kInterval_None };
+   OffsetInfo mScheduledOffsetInfo{ 0, false };
+   int mScheduledCustomDivisor{ 0 };
 };
 
 class Transport : public IDrawableModule, public IButtonListener, public IFloatSliderListener, public IDropdownListener
@@ -133,7 +159,7 @@ public:
    void SetDownbeat() { mMeasureTime = mMeasureTime - (int)mMeasureTime - .001; }
    static int CountInStandardMeasure(NoteInterval interval);
    void Reset(float rewindAmount = 0.005f);
-   void OnDrumEvent(NoteInterval drumEvent);
+   void OnDrumEvent(NoteInterval drumEvent, double time);
    void SetLoop(int measureStart, int measureEnd)
    {
       assert(measureStart < measureEnd);
@@ -173,6 +199,8 @@ public:
 
 private:
    void UpdateListeners(double jumpMs);
+   double GetEventTime(double oldTime, double newTime, int oldStep, const TransportListenerInfo* listenerInfo);
+   double GetNextEventTime(double time, const TransportListenerInfo* listenerInfo);
    double Swing(double measurePos);
    double SwingBeat(double pos);
    void Nudge(double amount);
@@ -212,6 +240,15 @@ private:
    int mLoopEndMeasure;
    bool mWantSetRandomTempo{ false };
 
+   //the timing that listener schedules were worked out with. when any of it changes, every listener gets rescheduled
+   int mScheduleGeneration{ 0 };
+   float mScheduledTempo{ 0 };
+   int mScheduledTimeSigTop{ 0 };
+   int mScheduledTimeSigBottom{ 0 };
+   float mScheduledSwing{ 0 };
+   int mScheduledSwingInterval{ 0 };
+   double mScheduledMeasureTime{ 0 };
+
    std::list<TransportListenerInfo> mListeners;
    std::list<IAudioPoller*> mAudioPollers;
 };
@@ -33,6 +33,7 @@
 
 TransposeFrom::TransposeFrom()
 {
+   mOutputBlock.reserve(kOutputBlockReserve);
    TheScale->AddListener(this);
 }
 
@@ -109,6 +110,46 @@ void TransposeFrom::PlayNote(double time, int pitch, int velocity, int voiceIdx,
    }
 }
 
+void TransposeFrom::PlayNoteBlock(const std::vector<NoteInputElement>& notes)
+{
+   if (!mEnabled)
+   {
+      PlayNoteOutputBlock(notes);
+      return;
+   }
+   if (mInNoteOutput)
+   {
+      INoteReceiver::PlayNoteBlock(notes);
+      return;
+   }
+
+   mOutputBlock.clear();
+   int transposeAmount = GetTransposeAmount();
+   for (const NoteInputElement& note : notes)
+   {
+      NoteInfo& inputNote = mInputNotes[note.pitch];
+      if (note.velocity > 0)
+      {
+         inputNote.mOn = true;
+         inputNote.mVelocity = note.velocity;
+         inputNote.mVoiceIdx = note.voiceIdx;
+         inputNote.mOutputPitch = note.pitch + transposeAmount;
+      }
+      else
+      {
+         inputNote.mOn = false;
+      }
+
+      if (inputNote.mOutputPitch >= 0 && inputNote.mOutputPitch < 128)
+      {
+         mOutputBlock.push_back(note);
+         mOutputBlock.back().pitch = inputNote.mOutputPitch;
+         mOutputBlock.back().voiceIdx = inputNote.mVoiceIdx;
+      }
+   }
+   PlayNoteOutputBlock(mOutputBlock);
+}
+
 void TransposeFrom::OnScaleChanged()
 {
    OnRootChanged();
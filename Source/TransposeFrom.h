@@ -48,6 +48,7 @@ public:
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
+   void PlayNoteBlock(const std::vector<NoteInputElement>& notes) override;
 
    //IScaleListener
    void OnScaleChanged() override;
@@ -69,6 +70,7 @@ private:
 
    //IDrawableModule
    void DrawModule() override;
+   bool CanCacheDrawing() const override { return true; }
    void GetModuleDimensions(float& width, float& height) override
    {
       width = mWidth;
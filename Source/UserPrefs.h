@@ -311,6 +311,8 @@ public:
    UserPrefBool show_tooltips_on_load{ "show_tooltips_on_load", true, UserPrefCategory::General };
    UserPrefBool show_minimap{ "show_minimap", false, UserPrefCategory::General };
    UserPrefTextEntryFloat record_buffer_length_minutes{ "record_buffer_length_minutes", 30, 1, 120, 5, UserPrefCategory::General };
+   UserPrefTextEntryInt sample_cache_mb{ "sample_cache_mb", 512, 0, 65536, 5, UserPrefCategory::General };
+   UserPrefBool resample_samples_on_load{ "resample_samples_on_load", false, UserPrefCategory::General };
 #if !BESPOKE_LINUX
    UserPrefBool vst_always_on_top{ "vst_always_on_top", true, UserPrefCategory::General };
 #endif
@@ -328,6 +330,9 @@ public:
    UserPrefFloat background_b{ "background_b", 0.09f, 0, 1, UserPrefCategory::Graphics };
    UserPrefFloat motion_trails{ "motion_trails", 1, 0, 2, UserPrefCategory::Graphics };
    UserPrefBool draw_module_highlights{ "draw_module_highlights", true, UserPrefCategory::Graphics };
+   UserPrefBool cache_module_rendering{ "cache_module_rendering", true, UserPrefCategory::Graphics };
+   UserPrefBool lower_frame_rate_when_idle{ "lower_frame_rate_when_idle", false, UserPrefCategory::Graphics };
+   UserPrefTextEntryInt idle_frame_rate{ "idle_frame_rate", 20, 1, 60, 5, UserPrefCategory::Graphics };
    UserPrefTextEntryFloat mouse_offset_x{ "mouse_offset_x", 0, -100, 100, 5, UserPrefCategory::Graphics };
    UserPrefTextEntryFloat mouse_offset_y
    {
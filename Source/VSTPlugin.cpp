@@ -158,6 +158,7 @@ namespace VSTLookup
 VSTPlugin::VSTPlugin()
 : IAudioProcessor(gBufferSize)
 {
+   SetPollRate(kMaxPollRate);
    juce::File(ofToDataPath("vst")).createDirectory();
    juce::File(ofToDataPath("vst/presets")).createDirectory();
 
@@ -647,7 +648,7 @@ void VSTPlugin::PlayNote(double time, int pitch, int velocity, int voiceIdx, Mod
 
    const juce::ScopedLock lock(mMidiInputLock);
 
-   int sampleNumber = (time - gTime) * gSampleRateMs;
+   int sampleNumber = GetBufferSampleIndex(time);
    //ofLog() << sampleNumber;
 
    if (velocity > 0)
@@ -0,0 +1,73 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    VizBuffer.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "VizBuffer.h"
+#include "SynthGlobals.h"
+
+namespace
+{
+   const double kWatchTimeoutMs = 250;
+}
+
+VizBuffer::VizBuffer(int sizeInSamples)
+: RollingBuffer(sizeInSamples)
+{
+}
+
+void VizBuffer::Watch()
+{
+   mWatchedUntil = gTime + kWatchTimeoutMs;
+}
+
+bool VizBuffer::IsWatched() const
+{
+   return gTime < mWatchedUntil;
+}
+
+//audio thread
+bool VizBuffer::ShouldWrite()
+{
+   bool watched = IsWatched();
+   if (watched != mFilling)
+   {
+      ClearBuffer(); //so a reader never picks up a stale snapshot from the last time it was watched
+      mFilling = watched;
+   }
+   return watched;
+}
+
+void VizBuffer::WriteChunk(float* samples, int size, int channel)
+{
+   if (ShouldWrite())
+      RollingBuffer::WriteChunk(samples, size, channel);
+}
+
+void VizBuffer::Write(float sample, int channel)
+{
+   if (ShouldWrite())
+      RollingBuffer::Write(sample, channel);
+}
@@ -0,0 +1,54 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    VizBuffer.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+#include "RollingBuffer.h"
+
+//the recent output of an audio source, for patch cables and module highlights to draw.
+//drawing code calls Watch() every frame that it reads from the buffer. once nothing has for a little while,
+//writes from the audio thread are dropped, so sources that nobody can see don't pay for the copy
+class VizBuffer : public RollingBuffer
+{
+public:
+   explicit VizBuffer(int sizeInSamples);
+
+   void Watch();
+   bool IsWatched() const;
+
+   //these hide the RollingBuffer versions, so that writes through a VizBuffer* are skipped while unwatched
+   void WriteChunk(float* samples, int size, int channel);
+   void Write(float sample, int channel);
+
+private:
+   bool ShouldWrite();
+
+   std::atomic<double> mWatchedUntil{ 0 };
+   bool mFilling{ false };
+};
@@ -0,0 +1,176 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    WaveformPyramid.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "WaveformPyramid.h"
+#include "ChannelBuffer.h"
+
+#include <cmath>
+
+//grows the dirty range to cover [start, start+length). lock-free, since the audio thread calls this every block
+void WaveformPyramid::Invalidate(int start, int length)
+{
+   start = MAX(start, 0);
+   int end = start + length;
+   if (start >= end)
+      return;
+
+   uint64_t dirty = mDirtyRange.load();
+   uint64_t grown;
+   do
+   {
+      int dirtyStart = int(dirty >> 32);
+      int dirtyEnd = int(dirty & 0xffffffff);
+      if (dirtyStart < dirtyEnd)
+      {
+         if (dirtyStart <= start && dirtyEnd >= end)
+            return; //already covered
+         grown = PackRange(MIN(dirtyStart, start), MAX(dirtyEnd, end));
+      }
+      else
+      {
+         grown = PackRange(start, end);
+      }
+   } while (!mDirtyRange.compare_exchange_weak(dirty, grown));
+}
+
+void WaveformPyramid::Update(ChannelBuffer* buffer)
+{
+   uint64_t dirty = mDirtyRange.exchange(0);
+   int start = int(dirty >> 32);
+   int end = int(dirty & 0xffffffff);
+
+   int numChannels = MIN(buffer->NumActiveChannels(), 2);
+   if (buffer->BufferSize() != mBufferSize || numChannels != mNumChannels)
+   {
+      mBufferSize = buffer->BufferSize();
+      mNumChannels = numChannels;
+      for (int ch = 0; ch < 2; ++ch)
+      {
+         mLevels[ch].clear();
+         if (ch >= mNumChannels)
+            continue;
+         int numBlocks = (mBufferSize + kBaseBlockSize - 1) / kBaseBlockSize;
+         while (true)
+         {
+            mLevels[ch].emplace_back(numBlocks);
+            if (numBlocks <= 1)
+               break;
+            numBlocks = (numBlocks + 1) / 2;
+         }
+      }
+      start = 0;
+      end = mBufferSize;
+   }
+
+   start = MAX(start, 0);
+   end = MIN(end, mBufferSize);
+   if (start < end)
+      Rebuild(buffer, start, end);
+}
+
+void WaveformPyramid::Rebuild(ChannelBuffer* buffer, int start, int end)
+{
+   for (int ch = 0; ch < mNumChannels; ++ch)
+   {
+      const float* data = buffer->GetChannel(ch);
+      std::vector<Block>& base = mLevels[ch][0];
+      int firstBlock = start / kBaseBlockSize;
+      int lastBlock = (end - 1) / kBaseBlockSize;
+      for (int i = firstBlock; i <= lastBlock; ++i)
+      {
+         int blockStart = i * kBaseBlockSize;
+         int blockEnd = MIN(blockStart + kBaseBlockSize, mBufferSize);
+         Block block;
+         block.mMin = block.mMax = data[blockStart];
+         float sumSquares = 0;
+         for (int j = blockStart; j < blockEnd; ++j)
+         {
+            block.mMin = MIN(block.mMin, data[j]);
+            block.mMax = MAX(block.mMax, data[j]);
+            sumSquares += data[j] * data[j];
+         }
+         block.mRms = sqrtf(sumSquares / (blockEnd - blockStart));
+         base[i] = block;
+      }
+
+      for (size_t level = 1; level < mLevels[ch].size(); ++level)
+      {
+         const std::vector<Block>& below = mLevels[ch][level - 1];
+         std::vector<Block>& current = mLevels[ch][level];
+         firstBlock /= 2;
+         lastBlock /= 2;
+         for (int i = firstBlock; i <= lastBlock; ++i)
+         {
+            if (i * 2 + 1 < (int)below.size())
+               current[i] = Merge(below[i * 2], below[i * 2 + 1]);
+            else
+               current[i] = below[i * 2];
+         }
+      }
+   }
+}
+
+//static
+WaveformPyramid::Block WaveformPyramid::Merge(const Block& a, const Block& b)
+{
+   Block merged;
+   merged.mMin = MIN(a.mMin, b.mMin);
+   merged.mMax = MAX(a.mMax, b.mMax);
+   merged.mRms = sqrtf((a.mRms * a.mRms + b.mRms * b.mRms) * .5f);
+   return merged;
+}
+
+//summary of [start, end), rounded out to whole blocks
+WaveformPyramid::Block WaveformPyramid::GetRange(int channel, int start, int end) const
+{
+   Block result;
+   if (channel >= mNumChannels || mBufferSize <= 0)
+      return result;
+
+   start = MAX(0, MIN(start, mBufferSize - 1));
+   end = MAX(start + 1, MIN(end, mBufferSize));
+
+   //the coarsest level that still has at least two blocks across the range
+   int level = 0;
+   while (level + 1 < (int)mLevels[channel].size() && (kBaseBlockSize << (level + 1)) * 2 <= end - start)
+      ++level;
+
+   const std::vector<Block>& blocks = mLevels[channel][level];
+   int blockSize = kBaseBlockSize << level;
+   float sumSquares = 0;
+   int firstBlock = start / blockSize;
+   int lastBlock = (end - 1) / blockSize;
+   result = blocks[firstBlock];
+   for (int i = firstBlock; i <= lastBlock; ++i)
+   {
+      result.mMin = MIN(result.mMin, blocks[i].mMin);
+      result.mMax = MAX(result.mMax, blocks[i].mMax);
+      sumSquares += blocks[i].mRms * blocks[i].mRms;
+   }
+   result.mRms = sqrtf(sumSquares / (lastBlock - firstBlock + 1));
+   return result;
+}
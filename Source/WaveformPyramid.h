@@ -0,0 +1,66 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    WaveformPyramid.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class ChannelBuffer;
+
+//min/max/rms summaries of a ChannelBuffer at successively halved resolutions, so drawing a
+//zoomed-out waveform reads a handful of summary blocks per column rather than the raw samples.
+//Invalidate() can be called from any thread after writing into the buffer. Update() and the
+//queries belong to the drawing thread
+class WaveformPyramid
+{
+public:
+   struct Block
+   {
+      float mMin{ 0 };
+      float mMax{ 0 };
+      float mRms{ 0 };
+   };
+
+   void Invalidate(int start, int length);
+   void Update(ChannelBuffer* buffer);
+   Block GetRange(int channel, int start, int end) const;
+
+   static const int kBaseBlockSize = 256;
+
+private:
+   void Rebuild(ChannelBuffer* buffer, int start, int end);
+   static Block Merge(const Block& a, const Block& b);
+   static uint64_t PackRange(int start, int end) { return (uint64_t(uint32_t(start)) << 32) | uint32_t(end); }
+
+   std::vector<std::vector<Block>> mLevels[2]; //[channel][level][block], level n covers kBaseBlockSize << n samples per block
+   int mBufferSize{ -1 };
+   int mNumChannels{ 0 };
+
+   std::atomic<uint64_t> mDirtyRange{ 0 }; //start in the high half and end in the low half, so they're always updated together. empty when start >= end
+};
@@ -134,7 +134,42 @@ void WaveformViewer::DrawModule()
    float phaseStart = (FTWO_PI - mVizPhase[mDoubleBufferFlip]) / vizPhaseInc;
    float end = lengthSamples - (FTWO_PI / vizPhaseInc);
 
-   if (mDrawWaveform)
+   if (mDrawWaveform && end / w > 2)
+   {
+      //several samples per pixel, so a line through them would just scribble over each column. fill each column's range instead
+      int numColumns = MAX(1, int(w));
+      static std::vector<float> sX, sTop, sBottom;
+      sX.resize(numColumns);
+      sTop.assign(numColumns, h);
+      sBottom.assign(numColumns, 0);
+      for (int i = phaseStart; i < lengthSamples; i++)
+      {
+         float x = ofMap(i - phaseStart, 0, end, 0, w, true);
+         float samp = mAudioView[(i + mBufferVizOffset[mDoubleBufferFlip]) % lengthSamples][mDoubleBufferFlip];
+         samp *= mDrawGain;
+         if (x < w)
+         {
+            int column = MIN(int(x), numColumns - 1);
+            float y = h / 2 - samp * (h / 2);
+            sTop[column] = MIN(sTop[column], y - 1); //pad by half the line width
+            sBottom[column] = MAX(sBottom[column], y + 1);
+         }
+      }
+      for (int column = 0; column < numColumns; ++column)
+      {
+         sX[column] = column + .5f;
+         if (sTop[column] > sBottom[column]) //no samples landed here
+         {
+            sTop[column] = column > 0 ? sTop[column - 1] : h / 2;
+            sBottom[column] = column > 0 ? sBottom[column - 1] : h / 2;
+         }
+      }
+      ofPushStyle();
+      ofFill();
+      ofFilledEnvelope(sX.data(), sTop.data(), sBottom.data(), numColumns);
+      ofPopStyle();
+   }
+   else if (mDrawWaveform)
    {
       ofBeginShape();
       for (int i = phaseStart; i < lengthSamples; i++)
@@ -14,6 +14,8 @@ public:
 					allpass();
 			void	setbuffer(float *buf, int size);
 	inline  float	process(float inp);
+	inline  void	processblock(float *inout, int numsamples);
+	inline  void	processsegment(float *inout, float *buf, int numsamples);
 			void	mute();
 			void	setfeedback(float val);
 			float	getfeedback();
@@ -43,6 +45,35 @@ inline float allpass::process(float input)
 	return output;
 }
 
+// Processes numsamples (at most bufsize) in place, as at most two
+// contiguous segments of the delay line. Since the delay is at least
+// as long as the block, every read comes from a previous block and
+// the loops have no serial dependency.
+
+inline void allpass::processblock(float *inout, int numsamples)
+{
+	int first = bufsize - bufidx;
+	if (first > numsamples) first = numsamples;
+
+	processsegment(inout, buffer + bufidx, first);
+	processsegment(inout + first, buffer, numsamples - first);
+
+	bufidx += numsamples;
+	if (bufidx >= bufsize) bufidx -= bufsize;
+}
+
+inline void allpass::processsegment(float *inout, float *buf, int numsamples)
+{
+	for (int i=0; i<numsamples; i++)
+	{
+		float input = inout[i];
+		float bufout = flushdenormal(buf[i]);
+
+		inout[i] = -input + bufout;
+		buf[i] = input + (bufout*feedback);
+	}
+}
+
 #endif//_allpass
 
 //ends
\ No newline at end of file
@@ -8,8 +8,18 @@
 #ifndef _denormals_
 #define _denormals_
 
+#include <float.h>
+#include <math.h>
+
 #define undenormalise(sample) if(((*(unsigned int*)&sample)&0x7f800000)==0) sample=0.0f
 
+// Branchless equivalent of undenormalise, for use in loops
+// that the compiler should be able to vectorise
+inline float flushdenormal(float sample)
+{
+	return (fabsf(sample) < FLT_MIN) ? 0.0f : sample;
+}
+
 #endif//_denormals_
 
 //ends
@@ -32,6 +32,9 @@ public:
 			float	getmode();
 			void	update();
 private:
+			void	process(float *inputL, float *inputR, float *outputL, float *outputR, long numsamples, int skip, bool replace);
+			void	processcombs(float *input, float *outL, float *outR, int numsamples);
+
 	float	gain;
 	float	roomsize,roomsize1;
 	float	damp,damp1;
@@ -44,9 +47,15 @@ private:
 	// to remove the need for dynamic allocation
 	// with its subsequent error-checking messiness
 
-	// Comb filters
-	comb	combL[numcombs];
-	comb	combR[numcombs];
+	// Comb filters, stored as lanes so that all of them
+	// (left lanes first, then right) are processed side by side.
+	// They all share the same feedback and damping.
+	float	combfeedback;
+	float	combdamp1,combdamp2;
+	float	combstore[numcomblanes];
+	float	*combbuffer[numcomblanes];
+	int		combsize[numcomblanes];
+	int		combidx[numcomblanes];
 
 	// Allpass filters
 	allpass	allpassL[numallpasses];
@@ -25,6 +25,13 @@ const float initialmode		= 0.0f;
 const float freezemode		= 1.0f;
 const int	stereospread	= 23;
 
+// The left and right comb banks are run side by side as lanes,
+// and everything is processed in blocks of at most blocksize samples.
+// blocksize must not exceed the shortest delay line (allpasstuningL4),
+// so that a block never reads back a value it wrote itself.
+const int	numcomblanes	= numcombs*2;
+const int	blocksize		= 64;
+
 // These values assume 44.1KHz sample rate
 // they will probably be OK for 48KHz sample rate
 // but would need scaling for 96KHz (or other) sample rates.
@@ -9,22 +9,22 @@
 revmodel::revmodel()
 {
 	// Tie the components to their buffers
-	combL[0].setbuffer(bufcombL1,combtuningL1);
-	combR[0].setbuffer(bufcombR1,combtuningR1);
-	combL[1].setbuffer(bufcombL2,combtuningL2);
-	combR[1].setbuffer(bufcombR2,combtuningR2);
-	combL[2].setbuffer(bufcombL3,combtuningL3);
-	combR[2].setbuffer(bufcombR3,combtuningR3);
-	combL[3].setbuffer(bufcombL4,combtuningL4);
-	combR[3].setbuffer(bufcombR4,combtuningR4);
-	combL[4].setbuffer(bufcombL5,combtuningL5);
-	combR[4].setbuffer(bufcombR5,combtuningR5);
-	combL[5].setbuffer(bufcombL6,combtuningL6);
-	combR[5].setbuffer(bufcombR6,combtuningR6);
-	combL[6].setbuffer(bufcombL7,combtuningL7);
-	combR[6].setbuffer(bufcombR7,combtuningR7);
-	combL[7].setbuffer(bufcombL8,combtuningL8);
-	combR[7].setbuffer(bufcombR8,combtuningR8);
+	float *bufcombL[numcombs] = { bufcombL1, bufcombL2, bufcombL3, bufcombL4, bufcombL5, bufcombL6, bufcombL7, bufcombL8 };
+	float *bufcombR[numcombs] = { bufcombR1, bufcombR2, bufcombR3, bufcombR4, bufcombR5, bufcombR6, bufcombR7, bufcombR8 };
+	const int tuningL[numcombs] = { combtuningL1, combtuningL2, combtuningL3, combtuningL4, combtuningL5, combtuningL6, combtuningL7, combtuningL8 };
+	const int tuningR[numcombs] = { combtuningR1, combtuningR2, combtuningR3, combtuningR4, combtuningR5, combtuningR6, combtuningR7, combtuningR8 };
+	for (int i=0; i<numcombs; i++)
+	{
+		combbuffer[i] = bufcombL[i];
+		combsize[i] = tuningL[i];
+		combbuffer[numcombs+i] = bufcombR[i];
+		combsize[numcombs+i] = tuningR[i];
+	}
+	for (int i=0; i<numcomblanes; i++)
+	{
+		combstore[i] = 0;
+		combidx[i] = 0;
+	}
 	allpassL[0].setbuffer(bufallpassL1,allpasstuningL1);
 	allpassR[0].setbuffer(bufallpassR1,allpasstuningR1);
 	allpassL[1].setbuffer(bufallpassL2,allpasstuningL2);
@@ -60,10 +60,10 @@ void revmodel::mute()
 		return;
 
 	int i;
-	for (i=0;i<numcombs;i++)
+	for (i=0;i<numcomblanes;i++)
 	{
-		combL[i].mute();
-		combR[i].mute();
+		for (int j=0; j<combsize[i]; j++)
+			combbuffer[i][j] = 0;
 	}
 	for (i=0;i<numallpasses;i++)
 	{
@@ -74,81 +74,136 @@ void revmodel::mute()
 
 void revmodel::processreplace(float *inputL, float *inputR, float *outputL, float *outputR, long numsamples, int skip)
 {
-	float outL,outR,input;
+	process(inputL, inputR, outputL, outputR, numsamples, skip, true);
+}
+
+void revmodel::processmix(float *inputL, float *inputR, float *outputL, float *outputR, long numsamples, int skip)
+{
+	process(inputL, inputR, outputL, outputR, numsamples, skip, false);
+}
+
+void revmodel::process(float *inputL, float *inputR, float *outputL, float *outputR, long numsamples, int skip, bool replace)
+{
+	float input[blocksize];
+	float outL[blocksize];
+	float outR[blocksize];
 
-	while(numsamples-- > 0)
+	while(numsamples > 0)
 	{
-		outL = outR = 0;
-		input = (*inputL + *inputR) * gain;
+		int n = (numsamples < blocksize) ? (int)numsamples : blocksize;
 
-		// Accumulate comb filters in parallel
 		int i;
-		for(i=0; i<numcombs; i++)
-		{
-			outL += combL[i].process(input);
-			outR += combR[i].process(input);
-		}
+		for(i=0; i<n; i++)
+			input[i] = (inputL[i*skip] + inputR[i*skip]) * gain;
+
+		// Accumulate comb filters in parallel
+		processcombs(input, outL, outR, n);
 
 		// Feed through allpasses in series
 		for(i=0; i<numallpasses; i++)
 		{
-			outL = allpassL[i].process(outL);
-			outR = allpassR[i].process(outR);
+			allpassL[i].processblock(outL, n);
+			allpassR[i].processblock(outR, n);
 		}
 
-		// Calculate output REPLACING anything already there
-		*outputL = outL*wet1 + outR*wet2 + *inputL*dry;
-		*outputR = outR*wet1 + outL*wet2 + *inputR*dry;
+		// Calculate output, allowing for interleave (if any).
+		// Left is written before right is read, same as the
+		// per-sample version, in case the buffers alias.
+		for(i=0; i<n; i++)
+		{
+			float l = outL[i]*wet1 + outR[i]*wet2 + inputL[i*skip]*dry;
+			if (replace)
+				outputL[i*skip] = l;
+			else
+				outputL[i*skip] += l;
+
+			float r = outR[i]*wet1 + outL[i]*wet2 + inputR[i*skip]*dry;
+			if (replace)
+				outputR[i*skip] = r;
+			else
+				outputR[i*skip] += r;
+		}
 
-		// Increment sample pointers, allowing for interleave (if any)
-		inputL += skip;
-		inputR += skip;
-		outputL += skip;
-		outputR += skip;
+		inputL += n*skip;
+		inputR += n*skip;
+		outputL += n*skip;
+		outputR += n*skip;
+		numsamples -= n;
 	}
 }
 
-void revmodel::processmix(float *inputL, float *inputR, float *outputL, float *outputR, long numsamples, int skip)
+void revmodel::processcombs(float *input, float *outL, float *outR, int numsamples)
 {
-	float outL,outR,input;
+	// Sample-major so that each sample's lanes are contiguous
+	float delayed[blocksize][numcomblanes];
+	float feedback[blocksize][numcomblanes];
+
+	int c,i;
 
-	while(numsamples-- > 0)
+	// Gather each comb's output for the block. No comb is shorter than a
+	// block, so this is at most two contiguous runs of its delay line.
+	for(c=0; c<numcomblanes; c++)
 	{
-		outL = outR = 0;
-		input = (*inputL + *inputR) * gain;
+		int first = combsize[c] - combidx[c];
+		if (first > numsamples) first = numsamples;
+		float *buf = combbuffer[c];
+		for(i=0; i<first; i++)
+			delayed[i][c] = buf[combidx[c]+i];
+		for(; i<numsamples; i++)
+			delayed[i][c] = buf[i-first];
+	}
 
-		int i;
-		// Accumulate comb filters in parallel
-		for(i=0; i<numcombs; i++)
+	// Damping is only serial in time, so run every comb at once
+	float store[numcomblanes];
+	for(c=0; c<numcomblanes; c++)
+		store[c] = combstore[c];
+	for(i=0; i<numsamples; i++)
+	{
+		float in = input[i];
+		for(c=0; c<numcomblanes; c++)
 		{
-			outL += combL[i].process(input);
-			outR += combR[i].process(input);
+			float output = flushdenormal(delayed[i][c]);
+			store[c] = flushdenormal((output*combdamp2) + (store[c]*combdamp1));
+			delayed[i][c] = output;
+			feedback[i][c] = in + (store[c]*combfeedback);
 		}
+	}
+	for(c=0; c<numcomblanes; c++)
+		combstore[c] = store[c];
 
-		// Feed through allpasses in series
-		for(i=0; i<numallpasses; i++)
+	// Scatter the new values back into the delay lines
+	for(c=0; c<numcomblanes; c++)
+	{
+		int first = combsize[c] - combidx[c];
+		if (first > numsamples) first = numsamples;
+		float *buf = combbuffer[c];
+		for(i=0; i<first; i++)
+			buf[combidx[c]+i] = feedback[i][c];
+		for(; i<numsamples; i++)
+			buf[i-first] = feedback[i][c];
+
+		combidx[c] += numsamples;
+		if (combidx[c] >= combsize[c]) combidx[c] -= combsize[c];
+	}
+
+	for(i=0; i<numsamples; i++)
+	{
+		float l = 0;
+		float r = 0;
+		for(c=0; c<numcombs; c++)
 		{
-			outL = allpassL[i].process(outL);
-			outR = allpassR[i].process(outR);
+			l += delayed[i][c];
+			r += delayed[i][numcombs+c];
 		}
-
-		// Calculate output MIXING with anything already there
-		*outputL += outL*wet1 + outR*wet2 + *inputL*dry;
-		*outputR += outR*wet1 + outL*wet2 + *inputR*dry;
-
-		// Increment sample pointers, allowing for interleave (if any)
-		inputL += skip;
-		inputR += skip;
-		outputL += skip;
-		outputR += skip;
+		outL[i] = l;
+		outR[i] = r;
 	}
 }
 
 void revmodel::update()
 {
-// Recalculate internal values after parameter change
-
-	int i;
+// Recalculate internal values after parameter change.
+// These are picked up at the start of the next block.
 
 	wet1 = wet*(width/2 + 0.5f);
 	wet2 = wet*((1-width)/2);
@@ -166,17 +221,9 @@ void revmodel::update()
 		gain = fixedgain;
 	}
 
-	for(i=0; i<numcombs; i++)
-	{
-		combL[i].setfeedback(roomsize1);
-		combR[i].setfeedback(roomsize1);
-	}
-
-	for(i=0; i<numcombs; i++)
-	{
-		combL[i].setdamp(damp1);
-		combR[i].setdamp(damp1);
-	}
+	combfeedback = roomsize1;
+	combdamp1 = damp1;
+	combdamp2 = 1-damp1;
 }
 
 // The following get/set functions are not inlined, because